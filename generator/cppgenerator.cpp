@@ -186,6 +186,14 @@ void CppGenerator::generateClass(QTextStream &s, const AbstractMetaClass *metaCl
     if (hasMultipleInheritanceInAncestry(metaClass))
         s << "#include <set>" << endl;
 
+    // The iterator functions advance to the current position with std::advance.
+    if (supportsIteratorProtocol(metaClass))
+        s << "#include <iterator>" << endl;
+
+    // The "_map" variants of the methods keep the C++ pointers and the results in vectors.
+    if (generateMapMethods())
+        s << "#include <vector>" << endl;
+
     s << "#include \"" << getModuleHeaderFileName() << '"' << endl << endl;
 
     QString headerfile = fileNameForClass(metaClass);
@@ -312,6 +320,14 @@ void CppGenerator::generateClass(QTextStream &s, const AbstractMetaClass *metaCl
                 smd << endl << "};" << endl << endl;
             }
             writeMethodDefinition(md, overloads);
+            if (hasAsyncMethodWrapper(overloads)) {
+                writeAsyncMethodWrapper(s, overloads);
+                writeAsyncMethodDefinition(md, overloads);
+            }
+            if (hasMapMethodWrapper(overloads)) {
+                writeMapMethodWrapper(s, rfunc);
+                writeMapMethodDefinition(md, rfunc);
+            }
         }
     }
 
@@ -471,11 +487,65 @@ void CppGenerator::writeConstructorNative(QTextStream& s, const AbstractMetaFunc
     s << '}' << endl << endl;
 }
 
+void CppGenerator::writeQueuedVirtualMethodCall(QTextStream& s, const AbstractMetaFunction* func)
+{
+    QString wrapper = wrapperName(func->ownerClass());
+    QStringList params;
+    QStringList members;
+    QStringList initializers;
+    QStringList argNames;
+    foreach (const AbstractMetaArgument* arg, func->arguments()) {
+        QString typeName = arg->type()->cppSignature();
+        if (arg->type()->isReference())
+            typeName.remove(QRegExp("^const\\s+")).remove(QRegExp("\\s*&$"));
+        params << QString("const %1& %2").arg(typeName).arg(arg->name());
+        members << QString("%1 %2;").arg(typeName).arg(arg->name());
+        initializers << QString("%1(%1)").arg(arg->name());
+        argNames << arg->name();
+    }
+
+    s << INDENT << "if (!PyGILState_GetThisThreadState()) {" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "// A thread unknown to Python: copies the arguments and returns, the call is made later by a thread holding the GIL." << endl;
+        s << INDENT << "struct QueuedCall : public Shiboken::QueuedCall" << endl;
+        s << INDENT << '{' << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "QueuedCall(" << wrapper << "* " PYTHON_SELF_VAR;
+            foreach (const QString& param, params)
+                s << ", " << param;
+            s << ')' << endl;
+            s << INDENT << "    : Shiboken::QueuedCall(" PYTHON_SELF_VAR "), " PYTHON_SELF_VAR "(" PYTHON_SELF_VAR ")";
+            foreach (const QString& initializer, initializers)
+                s << ", " << initializer;
+            s << " {}" << endl;
+            s << INDENT << "void call() { " PYTHON_SELF_VAR "->" << wrapper << "::" << func->originalName() << '(' << argNames.join(", ") << "); }" << endl;
+            s << INDENT << wrapper << "* " PYTHON_SELF_VAR ";" << endl;
+            foreach (const QString& member, members)
+                s << INDENT << member << endl;
+        }
+        s << INDENT << "};" << endl;
+        s << INDENT << "Shiboken::QueuedCalls::post(new QueuedCall(const_cast<" << wrapper << "*>(this)";
+        foreach (const QString& argName, argNames)
+            s << ", " << argName;
+        s << "));" << endl;
+        s << INDENT << "return;" << endl;
+    }
+    s << INDENT << '}' << endl << endl;
+}
+
 void CppGenerator::writeDestructorNative(QTextStream &s, const AbstractMetaClass *metaClass)
 {
     Indentation indentation(INDENT);
     s << wrapperName(metaClass) << "::~" << wrapperName(metaClass) << "()" << endl << '{' << endl;
     // kill pyobject
+    foreach (const AbstractMetaFunction* func, metaClass->functions()) {
+        if (func->isVirtual() && isQueuedVirtualMethod(func)) {
+            s << INDENT << "Shiboken::QueuedCalls::cancel(this);" << endl;
+            break;
+        }
+    }
     s << INDENT << "SbkObject* wrapper = Shiboken::BindingManager::instance().retrieveWrapper(this);" << endl;
     s << INDENT << "Shiboken::Object::destroy(wrapper, this);" << endl;
     s << '}' << endl;
@@ -570,6 +640,9 @@ void CppGenerator::writeVirtualMethodNative(QTextStream&s, const AbstractMetaFun
         return;
     }
 
+    if (isQueuedVirtualMethod(func))
+        writeQueuedVirtualMethodCall(s, func);
+
     //Write declaration/native injected code
     if (func->hasInjectedCode()) {
         CodeSnipList snips = func->injectedCodeSnips();
@@ -587,8 +660,11 @@ void CppGenerator::writeVirtualMethodNative(QTextStream&s, const AbstractMetaFun
         s << INDENT << "return " << defaultReturnExpr << ';' << endl;
     }
 
-    s << INDENT << "Shiboken::AutoDecRef " PYTHON_OVERRIDE_VAR "(Shiboken::BindingManager::instance().getOverride(this, \"";
-    s << funcName << "\"));" << endl;
+    QString methodName = staticStringReference(funcName);
+    if (methodName.isEmpty())
+        methodName = QString("\"%1\"").arg(funcName);
+    s << INDENT << "Shiboken::AutoDecRef " PYTHON_OVERRIDE_VAR "(Shiboken::BindingManager::instance().getOverride(this, ";
+    s << methodName << "));" << endl;
 
     s << INDENT << "if (" PYTHON_OVERRIDE_VAR ".isNull()) {" << endl;
     {
@@ -1135,21 +1211,22 @@ void CppGenerator::writeConverterRegister(QTextStream& s, const AbstractMetaClas
 
     s << endl;
 
-    QStringList cppSignature = metaClass->qualifiedCppName().split("::", QString::SkipEmptyParts);
-    while (!cppSignature.isEmpty()) {
-        QString signature = cppSignature.join("::");
-        s << INDENT << "Shiboken::Conversions::registerConverterName(converter, \"" << signature << "\");" << endl;
-        s << INDENT << "Shiboken::Conversions::registerConverterName(converter, \"" << signature << "*\");" << endl;
-        s << INDENT << "Shiboken::Conversions::registerConverterName(converter, \"" << signature << "&\");" << endl;
-        cppSignature.removeFirst();
-    }
-
-    s << INDENT << "Shiboken::Conversions::registerConverterName(converter, typeid(::";
-    s << metaClass->qualifiedCppName() << ").name());" << endl;
-    if (shouldGenerateCppWrapper(metaClass)) {
-        s << INDENT << "Shiboken::Conversions::registerConverterName(converter, typeid(::";
-        s << wrapperName(metaClass) << ").name());" << endl;
+    s << INDENT << "const char* converterNames[] = {" << endl;
+    {
+        Indentation indent(INDENT);
+        QStringList cppSignature = metaClass->qualifiedCppName().split("::", QString::SkipEmptyParts);
+        while (!cppSignature.isEmpty()) {
+            QString signature = cppSignature.join("::");
+            s << INDENT << '"' << signature << "\", \"" << signature << "*\", \"" << signature << "&\"," << endl;
+            cppSignature.removeFirst();
+        }
+        s << INDENT << "typeid(::" << metaClass->qualifiedCppName() << ").name()," << endl;
+        if (shouldGenerateCppWrapper(metaClass))
+            s << INDENT << "typeid(::" << wrapperName(metaClass) << ").name()," << endl;
+        s << INDENT << '0' << endl;
     }
+    s << INDENT << "};" << endl;
+    s << INDENT << "Shiboken::Conversions::registerConverterNames(converter, converterNames);" << endl;
 
     s << endl;
 
@@ -1512,6 +1589,9 @@ void CppGenerator::writeMethodWrapper(QTextStream& s, const AbstractMetaFunction
 
     writeFunctionCalls(s, overloadData);
 
+    if (rfunc->ownerClass() && isCachedHashType(rfunc->ownerClass()))
+        writeCachedHashReset(s, overloadData);
+
     if (callExtendedReverseOperator)
         s << endl << INDENT << "} // End of \"if (!" PYTHON_RETURN_VAR ")\"" << endl;
 
@@ -1792,6 +1872,13 @@ void CppGenerator::writeInvalidPyObjectCheck(QTextStream& s, const QString& pyOb
     s << INDENT << "return " << m_currentErrorCode << ';' << endl;
 }
 
+void CppGenerator::writeReadOnlyPyObjectCheck(QTextStream& s, const QString& pyObj)
+{
+    s << INDENT << "if (!Shiboken::Object::isWritable(" << pyObj << "))" << endl;
+    Indentation indent(INDENT);
+    s << INDENT << "return " << m_currentErrorCode << ';' << endl;
+}
+
 static QString pythonToCppConverterForArgumentName(const QString& argumentName)
 {
     static QRegExp pyArgsRegex(PYTHON_ARGS"(\\[\\d+[-]?\\d*\\])");
@@ -1865,6 +1952,14 @@ static void checkTypeViability(const AbstractMetaFunction* func)
 
 void CppGenerator::writeTypeCheck(QTextStream& s, const OverloadData* overloadData, QString argumentName)
 {
+    // Callback arguments followed by their removed user data take any Python callable.
+    const AbstractMetaFunction* refFunc = overloadData->referenceFunction();
+    const AbstractMetaArgument* refArg = overloadData->argument(refFunc);
+    if (refArg && isCallbackUserData(refFunc, refArg->argumentIndex() + 1)) {
+        s << "PyCallable_Check(" << argumentName << ')';
+        return;
+    }
+
     QSet<const TypeEntry*> numericTypes;
 
     foreach (OverloadData* od, overloadData->previousOverloadData()->nextOverloadData()) {
@@ -1903,6 +1998,20 @@ void CppGenerator::writeArgumentConversion(QTextStream& s,
         writeUnusedVariableCast(s, argName);
 }
 
+void CppGenerator::writeCallbackConversion(QTextStream& s, const AbstractMetaType* argType,
+                                           const QString& argName, const QString& pyArgName,
+                                           const QString& defaultValue)
+{
+    QString typeName = getFullTypeNameWithoutModifiers(argType);
+    QString callbackName = QString("%1_callback").arg(argName);
+    s << INDENT << "Shiboken::PythonCallback< " << typeName << " > " << callbackName << '(' << pyArgName << ");" << endl;
+    s << INDENT << typeName << ' ' << argName << " = ";
+    if (!defaultValue.isEmpty())
+        s << pyArgName << " ? " << callbackName << ".function() : " << defaultValue << ';' << endl;
+    else
+        s << callbackName << ".function();" << endl;
+}
+
 const AbstractMetaType* CppGenerator::getArgumentType(const AbstractMetaFunction* func, int argPos)
 {
     if (argPos < 0 || argPos > func->arguments().size()) {
@@ -1925,6 +2034,27 @@ const AbstractMetaType* CppGenerator::getArgumentType(const AbstractMetaFunction
     return argType;
 }
 
+#define LITERAL_PATTERN "(?:[-+]?(?:0[xX][0-9a-fA-F]+|\\d+\\.?\\d*(?:[eE][-+]?\\d+)?)[uUlLfF]*" \
+                        "|\"(?:[^\"\\\\]|\\\\.)*\"|'(?:[^'\\\\]|\\\\.)+'|true|false)"
+
+// Only literals, or constructor calls of \p typeName with literal arguments, are sure to
+// evaluate to the same value on every call; anything else may call functions with side effects
+// or refer to the object and the other arguments.
+static bool isConstantDefaultValue(const QString& defaultValue, const QString& typeName)
+{
+    static QRegExp literalRegex(LITERAL_PATTERN);
+    static QRegExp constructorRegex("(?:::)?([\\w:]+)\\s*\\(\\s*(?:" LITERAL_PATTERN "(?:\\s*,\\s*" LITERAL_PATTERN ")*)?\\s*\\)");
+    QString value = defaultValue.trimmed();
+    if (literalRegex.exactMatch(value))
+        return true;
+    if (!constructorRegex.exactMatch(value))
+        return false;
+    QString name = typeName;
+    if (name.startsWith("::"))
+        name.remove(0, 2);
+    return constructorRegex.cap(1) == name;
+}
+
 void CppGenerator::writePythonToCppTypeConversion(QTextStream& s,
                                                   const AbstractMetaType* type,
                                                   const QString& pyIn,
@@ -1950,9 +2080,20 @@ void CppGenerator::writePythonToCppTypeConversion(QTextStream& s,
 
     bool isProtectedEnum = false;
 
+    // Constant default values of const references are built once, on the first call that
+    // needs them, and shared by the following calls instead of built as a temporary each time.
+    // They are never deleted: a static object would be destroyed after Py_Finalize(), when its
+    // destructor may no longer use the interpreter or the wrapped library.
+    QString cppOutDefault;
+    if (mayHaveImplicitConversion && type->isConstant() && isConstantDefaultValue(defaultValue, typeName)) {
+        cppOutDefault = QString("%1_default").arg(cppOut);
+        s << INDENT << "static const " << typeName << "* " << cppOutDefault << " = new " << typeName;
+        s << '(' << defaultValue << ");" << endl;
+    }
+
     if (mayHaveImplicitConversion) {
         s << INDENT << typeName << ' ' << cppOutAux;
-        writeMinimalConstructorExpression(s, type, defaultValue);
+        writeMinimalConstructorExpression(s, type, cppOutDefault.isEmpty() ? defaultValue : QString());
         s << ';' << endl;
     } else if (avoidProtectedHack() && type->typeEntry()->isEnum()) {
         const AbstractMetaEnum* metaEnum = findAbstractMetaEnum(type);
@@ -1965,6 +2106,8 @@ void CppGenerator::writePythonToCppTypeConversion(QTextStream& s,
     s << INDENT << typeName;
     if (treatAsPointer || isPointerOrObjectType) {
         s << "* " << cppOut << (defaultValue.isEmpty() ? "" : QString(" = %1").arg(defaultValue));
+    } else if (!cppOutDefault.isEmpty()) {
+        s << "* " << cppOut << " = const_cast< " << typeName << "*>(" << cppOutDefault << ')';
     } else if (type->isReference() && !typeEntry->isPrimitive() && isNotContainerEnumOrFlags) {
         s << "* " << cppOut << " = &" << cppOutAux;
     } else {
@@ -2000,9 +2143,17 @@ void CppGenerator::writePythonToCppTypeConversion(QTextStream& s,
 
     s << "if (Shiboken::Conversions::isImplicitConversion((SbkObjectType*)";
     s << cpythonTypeNameExt(type) << ", " << pythonToCppFunc << "))" << endl;
-    {
+    if (cppOutDefault.isEmpty()) {
         Indentation indent(INDENT);
         s << INDENT << pythonToCppFunc << '(' << pyIn << ", &" << cppOutAux << ");" << endl;
+    } else {
+        s << INDENT << '{' << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << pythonToCppFunc << '(' << pyIn << ", &" << cppOutAux << ");" << endl;
+            s << INDENT << cppOut << " = &" << cppOutAux << ';' << endl;
+        }
+        s << INDENT << '}' << endl;
     }
     s << INDENT << "else" << endl;
     {
@@ -2271,6 +2422,17 @@ void CppGenerator::writeFunctionCalls(QTextStream& s, const OverloadData& overlo
     s << INDENT << '}' << endl;
 }
 
+// Non-member operators are added to the class of their first argument without it, losing
+// its constness, so operators are trusted not to modify the object, as C++ operators taking
+// their operands by const reference, unless they are in-place, increment or subscript ones.
+static bool operatorMayModifyObject(const AbstractMetaFunction* func)
+{
+    if (func->isInplaceOperator() || func->isCallOperator())
+        return true;
+    QString name = func->originalName();
+    return name == "operator=" || name == "operator++" || name == "operator--" || name == "operator[]";
+}
+
 void CppGenerator::writeSingleFunctionCall(QTextStream& s, const OverloadData& overloadData, const AbstractMetaFunction* func)
 {
     if (func->isDeprecated()) {
@@ -2285,6 +2447,13 @@ void CppGenerator::writeSingleFunctionCall(QTextStream& s, const OverloadData& o
         return;
     }
 
+    // Read only views of C++ const objects can't be modified through non const methods.
+    if (useConstReferenceViews() && func->ownerClass() && !func->ownerClass()->isNamespace()
+        && !func->isConstructor() && !func->isStatic() && !func->isConstant() && !func->isReverseOperator()
+        && (!func->isOperatorOverload() || operatorMayModifyObject(func))) {
+        writeReadOnlyPyObjectCheck(s, PYTHON_SELF_VAR);
+    }
+
     bool usePyArgs = pythonFunctionWrapperUsesListOfArguments(overloadData);
 
     // Handle named arguments.
@@ -2297,7 +2466,12 @@ void CppGenerator::writeSingleFunctionCall(QTextStream& s, const OverloadData& o
         bool hasConversionRule = !func->conversionRule(TypeSystem::NativeCode, argIdx + 1).isEmpty();
         const AbstractMetaArgument* arg = func->arguments().at(argIdx);
         if (func->argumentRemoved(argIdx + 1)) {
-            if (!arg->defaultValueExpression().isEmpty()) {
+            if (isCallbackUserData(func, argIdx)) {
+                // The callback made from the Python callable, converted just before, is its own user data.
+                QString cppArgRemoved = QString(CPP_ARG_REMOVED"%1").arg(argIdx);
+                s << INDENT << "void* " << cppArgRemoved << " = ";
+                s << QString(CPP_ARG"%1").arg(argIdx - 1 - removedArgs) << "_callback.userData();" << endl;
+            } else if (!arg->defaultValueExpression().isEmpty()) {
                 QString cppArgRemoved = QString(CPP_ARG_REMOVED"%1").arg(argIdx);
                 s << INDENT << getFullTypeName(arg->type()) << ' ' << cppArgRemoved;
                 s << " = " << guessScopeForDefaultValue(func, arg) << ';' << endl;
@@ -2321,6 +2495,10 @@ void CppGenerator::writeSingleFunctionCall(QTextStream& s, const OverloadData& o
         QString argName = QString(CPP_ARG"%1").arg(argPos);
         QString pyArgName = usePyArgs ? QString(PYTHON_ARGS "[%1]").arg(argPos) : PYTHON_ARG;
         QString defaultValue = guessScopeForDefaultValue(func, arg);
+        if (isCallbackUserData(func, argIdx + 1)) {
+            writeCallbackConversion(s, argType, argName, pyArgName, defaultValue);
+            continue;
+        }
         writeArgumentConversion(s, argType, argName, pyArgName, func->implementingClass(), defaultValue, func->isUserAdded());
     }
 
@@ -2400,19 +2578,144 @@ void CppGenerator::writeCppToPythonFunction(QTextStream& s, const CustomConversi
     replaceCppToPythonVariables(code, getFullTypeName(customConversion->ownerType()));
     writeCppToPythonFunction(s, code, fixedCppTypeName(customConversion->ownerType()));
 }
+// Conversions used for the STL containers whose type system entries don't define a conversion rule.
+static bool hasBuiltInContainerConversion(const TypeEntry* type)
+{
+    if (!type->isContainer() || !type->qualifiedCppName().startsWith("std::"))
+        return false;
+    switch (reinterpret_cast<const ContainerTypeEntry*>(type)->type()) {
+        case ContainerTypeEntry::ListContainer:
+        case ContainerTypeEntry::LinkedListContainer:
+        case ContainerTypeEntry::VectorContainer:
+        case ContainerTypeEntry::SetContainer:
+        case ContainerTypeEntry::MapContainer:
+        case ContainerTypeEntry::MultiMapContainer:
+        case ContainerTypeEntry::PairContainer:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static QString builtInContainerNativeToTargetConversion(const TypeEntry* type)
+{
+    QString code;
+    QTextStream c(&code);
+    switch (reinterpret_cast<const ContainerTypeEntry*>(type)->type()) {
+        case ContainerTypeEntry::SetContainer:
+            c << "PyObject* %out = PySet_New(0);" << endl;
+            c << "for (%INTYPE::const_iterator it = %in.begin(); it != %in.end(); ++it) {" << endl;
+            c << "    %INTYPE::const_reference cppItem = *it;" << endl;
+            c << "    PyObject* pyItem = %CONVERTTOPYTHON[%INTYPE_0](cppItem);" << endl;
+            c << "    if (!pyItem || PySet_Add(%out, pyItem) < 0) {" << endl;
+            c << "        Py_XDECREF(pyItem);" << endl;
+            c << "        Py_DECREF(%out);" << endl;
+            c << "        return 0;" << endl;
+            c << "    }" << endl;
+            c << "    Py_DECREF(pyItem);" << endl;
+            c << "}" << endl;
+            break;
+        case ContainerTypeEntry::MapContainer:
+        case ContainerTypeEntry::MultiMapContainer:
+            c << "PyObject* %out = PyDict_New();" << endl;
+            c << "for (%INTYPE::const_iterator it = %in.begin(); it != %in.end(); ++it) {" << endl;
+            c << "    const %INTYPE::key_type& cppKey = it->first;" << endl;
+            c << "    const %INTYPE::mapped_type& cppValue = it->second;" << endl;
+            c << "    Shiboken::AutoDecRef pyKey(%CONVERTTOPYTHON[%INTYPE_0](cppKey));" << endl;
+            c << "    Shiboken::AutoDecRef pyValue(%CONVERTTOPYTHON[%INTYPE_1](cppValue));" << endl;
+            c << "    if (pyKey.isNull() || pyValue.isNull() || PyDict_SetItem(%out, pyKey, pyValue) < 0) {" << endl;
+            c << "        Py_DECREF(%out);" << endl;
+            c << "        return 0;" << endl;
+            c << "    }" << endl;
+            c << "}" << endl;
+            break;
+        case ContainerTypeEntry::PairContainer:
+            c << "const %INTYPE::first_type& cppFirst = %in.first;" << endl;
+            c << "const %INTYPE::second_type& cppSecond = %in.second;" << endl;
+            c << "PyObject* %out = PyTuple_New(2);" << endl;
+            c << "PyTuple_SET_ITEM(%out, 0, %CONVERTTOPYTHON[%INTYPE_0](cppFirst));" << endl;
+            c << "PyTuple_SET_ITEM(%out, 1, %CONVERTTOPYTHON[%INTYPE_1](cppSecond));" << endl;
+            break;
+        default:
+            c << "PyObject* %out = PyList_New((int) %in.size());" << endl;
+            c << "%INTYPE::const_iterator it = %in.begin();" << endl;
+            c << "for (int idx = 0; it != %in.end(); ++it, ++idx) {" << endl;
+            c << "    %INTYPE::const_reference cppItem = *it;" << endl;
+            c << "    PyObject* pyItem = %CONVERTTOPYTHON[%INTYPE_0](cppItem);" << endl;
+            c << "    if (!pyItem) {" << endl;
+            c << "        Py_DECREF(%out);" << endl;
+            c << "        return 0;" << endl;
+            c << "    }" << endl;
+            c << "    PyList_SET_ITEM(%out, idx, pyItem);" << endl;
+            c << "}" << endl;
+    }
+    c << "return %out;" << endl;
+    return code;
+}
+
+static QString builtInContainerTargetToNativeConversion(const TypeEntry* type)
+{
+    QString code;
+    QTextStream c(&code);
+    ContainerTypeEntry::Type containerType = reinterpret_cast<const ContainerTypeEntry*>(type)->type();
+    switch (containerType) {
+        case ContainerTypeEntry::MapContainer:
+        case ContainerTypeEntry::MultiMapContainer:
+            c << "PyObject* key;" << endl;
+            c << "PyObject* value;" << endl;
+            c << "Py_ssize_t pos = 0;" << endl;
+            c << "while (PyDict_Next(%in, &pos, &key, &value)) {" << endl;
+            c << "    %OUTTYPE_0 cppKey = %CONVERTTOCPP[%OUTTYPE_0](key);" << endl;
+            c << "    %OUTTYPE_1 cppValue = %CONVERTTOCPP[%OUTTYPE_1](value);" << endl;
+            c << "    %out.insert(%OUTTYPE::value_type(cppKey, cppValue));" << endl;
+            c << "}" << endl;
+            break;
+        case ContainerTypeEntry::PairContainer:
+            c << "Shiboken::AutoDecRef seq(PySequence_Fast(%in, 0));" << endl;
+            c << "%OUTTYPE_0 cppFirst = %CONVERTTOCPP[%OUTTYPE_0](PySequence_Fast_GET_ITEM(seq.object(), 0));" << endl;
+            c << "%OUTTYPE_1 cppSecond = %CONVERTTOCPP[%OUTTYPE_1](PySequence_Fast_GET_ITEM(seq.object(), 1));" << endl;
+            c << "%out.first = cppFirst;" << endl;
+            c << "%out.second = cppSecond;" << endl;
+            break;
+        default:
+            // Sequences of numbers exporting a buffer are copied in one go.
+            if (containerType != ContainerTypeEntry::SetContainer) {
+                c << "if (Shiboken::Buffer::toContainer(%in, %out))" << endl;
+                c << "    return;" << endl;
+            }
+            c << "Shiboken::AutoDecRef seq(PySequence_Fast(%in, 0));" << endl;
+            c << "Py_ssize_t size = PySequence_Fast_GET_SIZE(seq.object());" << endl;
+            if (containerType == ContainerTypeEntry::VectorContainer)
+                c << "%out.reserve(size);" << endl;
+            c << "PyObject** pyItems = PySequence_Fast_ITEMS(seq.object());" << endl;
+            c << "for (Py_ssize_t i = 0; i < size; ++i) {" << endl;
+            c << "    %OUTTYPE_0 cppItem = %CONVERTTOCPP[%OUTTYPE_0](pyItems[i]);" << endl;
+            if (containerType == ContainerTypeEntry::SetContainer)
+                c << "    %out.insert(cppItem);" << endl;
+            else
+                c << "    %out.push_back(cppItem);" << endl;
+            c << "}" << endl;
+    }
+    return code;
+}
+
 void CppGenerator::writeCppToPythonFunction(QTextStream& s, const AbstractMetaType* containerType)
 {
     const CustomConversion* customConversion = containerType->typeEntry()->customConversion();
-    if (!customConversion) {
+    QString code;
+    if (customConversion) {
+        if (!containerType->typeEntry()->isContainer()) {
+            writeCppToPythonFunction(s, customConversion);
+            return;
+        }
+        code = customConversion->nativeToTargetConversion();
+    } else if (hasBuiltInContainerConversion(containerType->typeEntry())) {
+        code = builtInContainerNativeToTargetConversion(containerType->typeEntry());
+    } else {
         qFatal(qPrintable(QString("Can't write the C++ to Python conversion function for container type '%1' - "\
                                   "no conversion rule was defined for it in the type system.")
                              .arg(containerType->typeEntry()->qualifiedCppName())), NULL);
     }
-    if (!containerType->typeEntry()->isContainer()) {
-        writeCppToPythonFunction(s, customConversion);
-        return;
-    }
-    QString code = customConversion->nativeToTargetConversion();
     for (int i = 0; i < containerType->instantiations().count(); ++i)
         code.replace(QString("%INTYPE_%1").arg(i), getFullTypeName(containerType->instantiations().at(i)));
     replaceCppToPythonVariables(code, getFullTypeNameWithoutModifiers(containerType));
@@ -2541,13 +2844,18 @@ void CppGenerator::writePythonToCppConversionFunctions(QTextStream& s,
 
 void CppGenerator::writePythonToCppConversionFunctions(QTextStream& s, const AbstractMetaType* containerType)
 {
+    QString conversion;
     const CustomConversion* customConversion = containerType->typeEntry()->customConversion();
-    if (!customConversion) {
-        //qFatal
-        return;
-    }
-    const CustomConversion::TargetToNativeConversions& toCppConversions = customConversion->targetToNativeConversions();
-    if (toCppConversions.isEmpty()) {
+    if (customConversion) {
+        const CustomConversion::TargetToNativeConversions& toCppConversions = customConversion->targetToNativeConversions();
+        if (toCppConversions.isEmpty()) {
+            //qFatal
+            return;
+        }
+        conversion = toCppConversions.first()->conversion();
+    } else if (hasBuiltInContainerConversion(containerType->typeEntry())) {
+        conversion = builtInContainerTargetToNativeConversion(containerType->typeEntry());
+    } else {
         //qFatal
         return;
     }
@@ -2556,7 +2864,7 @@ void CppGenerator::writePythonToCppConversionFunctions(QTextStream& s, const Abs
     QString code;
     QTextStream c(&code);
     c << INDENT << QString("%1& cppOutRef = *((%1*)cppOut);").arg(cppTypeName) << endl;
-    code.append(toCppConversions.first()->conversion());
+    code.append(conversion);
     for (int i = 0; i < containerType->instantiations().count(); ++i) {
         const AbstractMetaType* type = containerType->instantiations().at(i);
         QString typeName = getFullTypeName(type);
@@ -2619,7 +2927,11 @@ void CppGenerator::writeNamedArgumentResolution(QTextStream& s, const AbstractMe
         foreach (const AbstractMetaArgument* arg, args) {
             int pyArgIndex = arg->argumentIndex() - OverloadData::numberOfRemovedArguments(func, arg->argumentIndex());
             QString pyArgName = usePyArgs ? QString(PYTHON_ARGS "[%1]").arg(pyArgIndex) : PYTHON_ARG;
-            s << "value = PyDict_GetItemString(kwds, \"" << arg->name() << "\");" << endl;
+            QString argName = staticStringReference(arg->name());
+            if (argName.isEmpty())
+                s << "value = PyDict_GetItemString(kwds, \"" << arg->name() << "\");" << endl;
+            else
+                s << "value = PyDict_GetItem(kwds, " << argName << ");" << endl;
             s << INDENT << "if (value && " << pyArgName << ") {" << endl;
             {
                 Indentation indent(INDENT);
@@ -2678,6 +2990,23 @@ QString CppGenerator::argumentNameFromIndex(const AbstractMetaFunction* func, in
     return pyArgName;
 }
 
+bool CppGenerator::returnsConstReferenceView(const AbstractMetaFunction* func)
+{
+    const AbstractMetaType* type = func->type();
+    if (!useConstReferenceViews() || !type || !type->isValue() || !type->isReference() || !type->isConstant()
+        || func->isStatic() || func->isOperatorOverload() || !func->ownerClass()
+        || func->hasInjectedCode() || !func->conversionRule(TypeSystem::TargetLangCode, 0).isEmpty()) {
+        return false;
+    }
+    // A reference returned by a method that receives no wrapped objects is taken as pointing
+    // inside the owner, and so can be tied to the owner's lifetime.
+    foreach (const AbstractMetaArgument* arg, func->arguments()) {
+        if (isWrapperType(arg->type()))
+            return false;
+    }
+    return true;
+}
+
 void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* func, int maxArgs)
 {
     s << INDENT << "// " << func->minimalSignature() << (func->isReverseOperator() ? " [reverse operator]": "") << endl;
@@ -2744,7 +3073,7 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                     // If have conversion rules I will use this for removed args
                     if (hasConversionRule)
                         userArgs << QString("%1"CONV_RULE_OUT_VAR_SUFFIX).arg(arg->name());
-                    else if (!arg->defaultValueExpression().isEmpty())
+                    else if (!arg->defaultValueExpression().isEmpty() || isCallbackUserData(func, i))
                         userArgs << QString(CPP_ARG_REMOVED"%1").arg(i);
                 } else {
                     int idx = arg->argumentIndex() - removedArgs;
@@ -2769,11 +3098,12 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                 const AbstractMetaArgument* arg = func->arguments().at(i);
                 bool defValModified = arg->defaultValueExpression() != arg->originalDefaultValueExpression();
                 bool hasConversionRule = !func->conversionRule(TypeSystem::NativeCode, arg->argumentIndex() + 1).isEmpty();
-                if (argsClear && !defValModified && !hasConversionRule)
+                bool isUserData = isCallbackUserData(func, i);
+                if (argsClear && !defValModified && !hasConversionRule && !isUserData)
                     continue;
                 else
                     argsClear = false;
-                otherArgsModified |= defValModified || hasConversionRule || func->argumentRemoved(i + 1);
+                otherArgsModified |= defValModified || hasConversionRule || isUserData || func->argumentRemoved(i + 1);
                 if (hasConversionRule)
                     otherArgs.prepend(QString("%1"CONV_RULE_OUT_VAR_SUFFIX).arg(arg->name()));
                 else
@@ -2888,7 +3218,28 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
         }
 
         if (!injectedCodeCallsCppFunction(func)) {
-            s << INDENT << BEGIN_ALLOW_THREADS << endl << INDENT;
+            // Value types returned by value are constructed straight into the heap storage
+            // the Python wrapper will own, instead of being copied there after the call.
+            bool constructReturnedValue = false;
+            if (!isCtor && func->type() && !func->isInplaceOperator() && func->type()->isValue()
+                && !func->type()->isReference() && func->type()->indirections() == 0
+                && !func->hasInjectedCode()
+                && func->conversionRule(TypeSystem::TargetLangCode, 0).isEmpty()) {
+                const AbstractMetaClass* returnedClass = classes().findClass(func->type()->typeEntry());
+                constructReturnedValue = returnedClass && !shouldGenerateCppWrapper(returnedClass);
+            }
+            // With automatic GIL release, calls that can't get back to Python release it depending on
+            // how long they take, and the others keep it unless they are marked with allow-thread.
+            bool autoRelease = useAutoGilRelease() && isGilReleaseEligible(func);
+            bool allowThreads = !useAutoGilRelease() || (!autoRelease && func->allowThread());
+            if (autoRelease) {
+                s << INDENT << "static Shiboken::CallTiming callTiming = SBK_CALL_TIMING_INITIALIZER;" << endl;
+                s << INDENT << "Shiboken::AutoThreadStateSaver " THREAD_STATE_SAVER_VAR "(callTiming);" << endl;
+                s << INDENT << THREAD_STATE_SAVER_VAR ".save();" << endl;
+            } else if (allowThreads) {
+                s << INDENT << BEGIN_ALLOW_THREADS << endl;
+            }
+            s << INDENT;
             if (isCtor) {
                 s << "cptr = ";
             } else if (func->type() && !func->isInplaceOperator()) {
@@ -2907,7 +3258,12 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                         writeReturnType = false;
                     }
                 }
-                if (writeReturnType) {
+                if (constructReturnedValue) {
+                    QString typeName = "::" + func->type()->typeEntry()->qualifiedCppName();
+                    s << typeName << '*';
+                    methodCall.prepend(QString("new %1(").arg(typeName));
+                    methodCall.append(')');
+                } else if (writeReturnType) {
                     s << func->type()->cppSignature();
                     if (isObjectTypeUsedAsValueType(func->type())) {
                         s << '*';
@@ -2918,16 +3274,22 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                 s << " " CPP_RETURN_VAR " = ";
             }
             s << methodCall << ';' << endl;
-            s << INDENT << END_ALLOW_THREADS << endl;
+            if (autoRelease)
+                s << INDENT << THREAD_STATE_SAVER_VAR ".restore();" << endl;
+            else if (allowThreads)
+                s << INDENT << END_ALLOW_THREADS << endl;
 
             if (!func->conversionRule(TypeSystem::TargetLangCode, 0).isEmpty()) {
                 writeConversionRule(s, func, TypeSystem::TargetLangCode, PYTHON_RETURN_VAR);
             } else if (!isCtor && !func->isInplaceOperator() && func->type()
                 && !injectedCodeHasReturnValueAttribution(func, TypeSystem::TargetLangCode)) {
                 s << INDENT << PYTHON_RETURN_VAR " = ";
-                if (isObjectTypeUsedAsValueType(func->type())) {
+                if (constructReturnedValue || isObjectTypeUsedAsValueType(func->type())) {
                     s << "Shiboken::Object::newObject((SbkObjectType*)" << cpythonTypeNameExt(func->type()->typeEntry());
                     s << ", " << CPP_RETURN_VAR << ", true, true)";
+                } else if (returnsConstReferenceView(func)) {
+                    s << "Shiboken::Object::borrowedObject(" PYTHON_SELF_VAR ", (SbkObjectType*)";
+                    s << cpythonTypeNameExt(func->type()->typeEntry()) << ", &" CPP_RETURN_VAR ", true)";
                 } else {
                     writeToPythonConversion(s, func->type(), func->ownerClass(), CPP_RETURN_VAR);
                 }
@@ -3270,6 +3632,35 @@ bool CppGenerator::supportsSequenceProtocol(const AbstractMetaClass* metaClass)
     return false;
 }
 
+// Returns the "begin" or "end" method of the class, if it is public, takes no arguments and returns
+// a pointer. The methods may be removed from the Python API, they are still used by the iterator.
+static const AbstractMetaFunction* findRangeFunction(const AbstractMetaClass* metaClass, const QString& funcName)
+{
+    const AbstractMetaFunction* func = metaClass->findFunction(funcName);
+    if (!func || func->isPrivate() || func->isProtected() || func->isStatic()
+        || !func->arguments().isEmpty() || !func->type()
+        || func->type()->isReference() || func->type()->indirections() != 1) {
+        return 0;
+    }
+    return func;
+}
+
+static bool isContainerClass(const AbstractMetaClass* metaClass)
+{
+    const ComplexTypeEntry* baseType = metaClass->typeEntry()->baseContainerType();
+    return baseType && baseType->isContainer() && !metaClass->templateBaseClassInstantiations().isEmpty();
+}
+
+bool CppGenerator::supportsIteratorProtocol(const AbstractMetaClass* metaClass)
+{
+    if (isContainerClass(metaClass))
+        return true;
+
+    const AbstractMetaFunction* begin = findRangeFunction(metaClass, "begin");
+    const AbstractMetaFunction* end = findRangeFunction(metaClass, "end");
+    return begin && end && begin->type()->cppSignature() == end->type()->cppSignature();
+}
+
 bool CppGenerator::shouldGenerateGetSetList(const AbstractMetaClass* metaClass)
 {
     foreach (AbstractMetaField* f, metaClass->fields()) {
@@ -3354,6 +3745,8 @@ void CppGenerator::writeClassDefinition(QTextStream& s, const AbstractMetaClass*
         && metaClass->hasToStringCapability()) {
         m_tpFuncs["__repr__"] = writeReprFunction(s, metaClass);
     }
+    if (m_tpFuncs["__iter__"] == "0" && supportsIteratorProtocol(metaClass))
+        m_tpFuncs["__iter__"] = writeIteratorFunctions(s, metaClass);
 
     // class or some ancestor has multiple inheritance
     const AbstractMetaClass* miClass = getMultipleInheritingClass(metaClass);
@@ -3449,6 +3842,11 @@ void CppGenerator::writeMappingMethods(QTextStream& s, const AbstractMetaClass*
 
         writeCppSelfDefinition(s, func);
 
+        if (it.key() == "__msetitem__" && isCachedHashType(metaClass)) {
+            s << INDENT << "// Assigning or deleting items may change the object hash." << endl;
+            writeCachedHashReset(s);
+        }
+
         const AbstractMetaArgument* lastArg = func->arguments().isEmpty() ? 0 : func->arguments().last();
         writeCodeSnips(s, snips, CodeSnip::Any, TypeSystem::TargetLangCode, func, lastArg);
         s << '}' << endl << endl;
@@ -3477,6 +3875,11 @@ void CppGenerator::writeSequenceMethods(QTextStream& s, const AbstractMetaClass*
 
         writeCppSelfDefinition(s, func);
 
+        if ((it.key() == "__setitem__" || it.key() == "__setslice__") && isCachedHashType(metaClass)) {
+            s << INDENT << "// Assigning or deleting items may change the object hash." << endl;
+            writeCachedHashReset(s);
+        }
+
         const AbstractMetaArgument* lastArg = func->arguments().isEmpty() ? 0 : func->arguments().last();
         writeCodeSnips(s, snips,CodeSnip::Any, TypeSystem::TargetLangCode, func, lastArg);
         s << '}' << endl << endl;
@@ -3655,7 +4058,9 @@ void CppGenerator::writeGetterFunction(QTextStream& s, const AbstractMetaField*
 
     AbstractMetaType* fieldType = metaField->type();
     // Force use of pointer to return internal variable memory
-    bool newWrapperSameObject = !fieldType->isConstant() && isWrapperType(fieldType) && !isPointer(fieldType);
+    bool newWrapperSameObject = isWrapperType(fieldType) && !isPointer(fieldType)
+                                && (!fieldType->isConstant()
+                                    || (useConstReferenceViews() && !(avoidProtectedHack() && metaField->isProtected())));
 
     QString cppField;
     if (avoidProtectedHack() && metaField->isProtected()) {
@@ -3685,7 +4090,11 @@ void CppGenerator::writeGetterFunction(QTextStream& s, const AbstractMetaField*
     }
 
     s << INDENT << "PyObject* pyOut = ";
-    if (newWrapperSameObject) {
+    if (newWrapperSameObject && useConstReferenceViews()) {
+        // The wrapper is kept by the owner and reused on the next accesses.
+        s << "Shiboken::Object::borrowedObject(" PYTHON_SELF_VAR ", (SbkObjectType*)" << cpythonTypeNameExt(fieldType);
+        s << ", " << cppField << (fieldType->isConstant() ? ", true)" : ")");
+    } else if (newWrapperSameObject) {
         s << "Shiboken::Object::newObject((SbkObjectType*)" << cpythonTypeNameExt(fieldType);
         s << ", " << cppField << ", false, true);" << endl;
         s << INDENT << "Shiboken::Object::setParent(" PYTHON_SELF_VAR ", pyOut)";
@@ -3705,6 +4114,8 @@ void CppGenerator::writeSetterFunction(QTextStream& s, const AbstractMetaField*
     s << '{' << endl;
 
     writeCppSelfDefinition(s, metaField->enclosingClass());
+    if (useConstReferenceViews())
+        writeReadOnlyPyObjectCheck(s, PYTHON_SELF_VAR);
 
     s << INDENT << "if (pyIn == 0) {" << endl;
     {
@@ -3755,10 +4166,69 @@ void CppGenerator::writeSetterFunction(QTextStream& s, const AbstractMetaField*
         s << metaField->name() << "\", pyIn);" << endl;
     }
 
+    if (isCachedHashType(metaField->enclosingClass()))
+        writeCachedHashReset(s);
+
     s << INDENT << "return 0;" << endl;
     s << '}' << endl;
 }
 
+// Returns true if the comparison operator takes an object of its own class and returns a plain bool.
+static bool isSameTypeComparison(const AbstractMetaFunction* func, const AbstractMetaClass* metaClass)
+{
+    if (func->isStatic() || func->isUserAdded() || func->hasInjectedCode() || func->isPointerOperator()
+        || func->arguments().size() != 1 || func->argumentRemoved(1)
+        || !func->typeReplaced(0).isEmpty() || !func->typeReplaced(1).isEmpty()
+        || !func->type() || func->type()->cppSignature() != "bool") {
+        return false;
+    }
+    const AbstractMetaType* argType = func->arguments().first()->type();
+    return argType->typeEntry() == metaClass->typeEntry()
+           && argType->indirections() == 0
+           && (!argType->isReference() || argType->isConstant());
+}
+
+void CppGenerator::writeRichCompareFastPath(QTextStream& s, const AbstractMetaClass* metaClass)
+{
+    QList<QPair<QString, QString> > operators;
+    foreach (AbstractMetaFunctionList overloads, filterGroupedOperatorFunctions(metaClass, AbstractMetaClass::ComparisonOp)) {
+        foreach (const AbstractMetaFunction* func, overloads) {
+            if (!isSameTypeComparison(func, metaClass))
+                continue;
+            QString op = func->originalName();
+            op = op.right(op.size() - QString("operator").size());
+            operators << qMakePair(ShibokenGenerator::pythonRichCompareOperatorId(func), op);
+            break;
+        }
+    }
+    if (operators.isEmpty())
+        return;
+
+    // Objects of the exact same type skip the overload decisor and the argument conversion.
+    s << INDENT << "if (Py_TYPE(" PYTHON_ARG ") == Py_TYPE(" PYTHON_SELF_VAR ") && Shiboken::Object::isValid(" PYTHON_ARG ", false)) {" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "const " << metaClass->qualifiedCppName() << "& cppOther = *" << cpythonWrapperCPtr(metaClass, PYTHON_ARG) << ';' << endl;
+        s << INDENT << "switch (op) {" << endl;
+        {
+            Indentation indent(INDENT);
+            typedef QPair<QString, QString> OperatorPair;
+            foreach (const OperatorPair& op, operators) {
+                s << INDENT << "case " << op.first << ':' << endl;
+                Indentation indent(INDENT);
+                s << INDENT << "return PyBool_FromLong(" CPP_SELF_VAR " " << op.second << " cppOther);" << endl;
+            }
+            s << INDENT << "default:" << endl;
+            {
+                Indentation indent(INDENT);
+                s << INDENT << "break;" << endl;
+            }
+        }
+        s << INDENT << '}' << endl;
+    }
+    s << INDENT << '}' << endl << endl;
+}
+
 void CppGenerator::writeRichCompareFunction(QTextStream& s, const AbstractMetaClass* metaClass)
 {
     QString baseName = cpythonBaseName(metaClass);
@@ -3772,6 +4242,8 @@ void CppGenerator::writeRichCompareFunction(QTextStream& s, const AbstractMetaCl
     writeUnusedVariableCast(s, PYTHON_TO_CPP_VAR);
     s << endl;
 
+    writeRichCompareFastPath(s, metaClass);
+
     s << INDENT << "switch (op) {" << endl;
     {
         Indentation indent(INDENT);
@@ -3914,6 +4386,175 @@ void CppGenerator::writeMethodDefinition(QTextStream& s, const AbstractMetaFunct
     s << ',' << endl;
 }
 
+bool CppGenerator::hasAsyncMethodWrapper(const AbstractMetaFunctionList overloads)
+{
+    if (!generateAsyncMethods() || m_tpFuncs.contains(overloads.first()->name())
+        || OverloadData::hasStaticAndInstanceFunctions(overloads))
+        return false;
+    return OverloadData(overloads, this).hasAllowThread();
+}
+
+void CppGenerator::writeAsyncMethodWrapper(QTextStream& s, const AbstractMetaFunctionList overloads)
+{
+    const AbstractMetaFunction* rfunc = overloads.first();
+    // Static methods get the type as the object holding them.
+    QString owner = PYTHON_SELF_VAR;
+    if (rfunc->isStatic())
+        owner = QString("reinterpret_cast<PyObject*>(%1)").arg(cpythonTypeNameExt(rfunc->ownerClass()->typeEntry()));
+
+    s << "static PyObject* " << cpythonFunctionName(rfunc) << "_async(PyObject* " PYTHON_SELF_VAR ", PyObject* args, PyObject* kwds)" << endl;
+    s << '{' << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "// The wrapped method converts the arguments and releases the GIL on a thread of the pool." << endl;
+        s << INDENT << "Shiboken::AutoDecRef method(PyObject_GetAttrString(" << owner << ", \"" << rfunc->name() << "\"));" << endl;
+        s << INDENT << "if (method.isNull())" << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "return 0;" << endl;
+        }
+        s << INDENT << "return Shiboken::Async::call(method, args, kwds);" << endl;
+    }
+    s << '}' << endl << endl;
+}
+
+void CppGenerator::writeAsyncMethodDefinition(QTextStream& s, const AbstractMetaFunctionList overloads)
+{
+    const AbstractMetaFunction* func = overloads.first();
+    s << INDENT << "{\"" << func->name() << "_async\", (PyCFunction)" << cpythonFunctionName(func) << "_async, ";
+    s << "METH_VARARGS|METH_KEYWORDS" << (func->isStatic() ? "|METH_STATIC" : "") << "}," << endl;
+}
+
+bool CppGenerator::hasMapMethodWrapper(const AbstractMetaFunctionList overloads)
+{
+    const AbstractMetaFunction* func = overloads.first();
+    if (!generateMapMethods() || overloads.count() != 1 || m_tpFuncs.contains(func->name())
+        || func->isStatic() || !func->isPublic() || func->isUserAdded() || func->hasInjectedCode()
+        || func->functionType() == AbstractMetaFunction::EmptyFunction || !func->arguments().isEmpty()
+        || !func->typeReplaced(0).isEmpty() || !func->conversionRule(TypeSystem::TargetLangCode, 0).isEmpty()) {
+        return false;
+    }
+    // The results are copied to a vector while the GIL is released, so only values are returned:
+    // no pointers, and no references to value types, which are given to Python as references.
+    const AbstractMetaType* type = func->type();
+    if (!type)
+        return true;
+    if (type->indirections() != 0)
+        return false;
+    if (type->isValue())
+        return !type->isReference() || type->isConstant();
+    return isCppPrimitive(type) || type->isEnum() || type->isContainer();
+}
+
+void CppGenerator::writeMapMethodWrapper(QTextStream& s, const AbstractMetaFunction* func)
+{
+    ErrorCode errorCode(0);
+    const AbstractMetaClass* metaClass = func->ownerClass();
+    QString className = QString("::%1").arg(metaClass->qualifiedCppName());
+    // Objects created from Python are called like the method wrapper does, without reaching
+    // their Python reimplementations, the others get a virtual call.
+    bool checkCppWrapper = func->isVirtual() && !func->isAbstract();
+    bool checkWritable = useConstReferenceViews() && !func->isConstant();
+    bool releaseGil = !useAutoGilRelease() || func->allowThread() || isGilReleaseEligible(func);
+
+    s << "static PyObject* " << cpythonFunctionName(func) << "_map(PyObject*, PyObject* " PYTHON_ARG ")" << endl;
+    s << '{' << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "Shiboken::AutoDecRef seq(PySequence_Fast(" PYTHON_ARG ", \"The objects must be a sequence.\"));" << endl;
+        s << INDENT << "if (seq.isNull())" << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "return 0;" << endl;
+        }
+        s << INDENT << "Py_ssize_t size = PySequence_Fast_GET_SIZE(seq.object());" << endl;
+        s << endl;
+        s << INDENT << "// All the objects are checked and their C++ pointers taken before the first call." << endl;
+        s << INDENT << "std::vector<" << className << "*> cppSelves(size);" << endl;
+        if (checkCppWrapper)
+            s << INDENT << "std::vector<bool> hasCppWrapper(size);" << endl;
+        s << INDENT << "for (Py_ssize_t i = 0; i < size; ++i) {" << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "PyObject* item = PySequence_Fast_GET_ITEM(seq.object(), i);" << endl;
+            s << INDENT << "if (!" << cpythonCheckFunction(metaClass->typeEntry()) << "item)) {" << endl;
+            {
+                Indentation indent(INDENT);
+                s << INDENT << "PyErr_Format(PyExc_TypeError, \"'%s' object is not a '" << metaClass->name();
+                s << "'.\", Py_TYPE(item)->tp_name);" << endl;
+                s << INDENT << "return 0;" << endl;
+            }
+            s << INDENT << '}' << endl;
+            writeInvalidPyObjectCheck(s, "item");
+            if (checkWritable)
+                writeReadOnlyPyObjectCheck(s, "item");
+            s << INDENT << "cppSelves[i] = " << cpythonWrapperCPtr(metaClass, "item") << ';' << endl;
+            if (checkCppWrapper)
+                s << INDENT << "hasCppWrapper[i] = Shiboken::Object::hasCppWrapper(reinterpret_cast<SbkObject*>(item));" << endl;
+        }
+        s << INDENT << '}' << endl;
+        s << endl;
+
+        QString call = QString("cppSelves[i]->%1()").arg(func->originalName());
+        if (checkCppWrapper) {
+            call = QString("(hasCppWrapper[i] ? cppSelves[i]->%1::%2() : %3)")
+                      .arg(className).arg(func->originalName()).arg(call);
+        }
+        if (func->type()) {
+            s << INDENT << "std::vector<" << getFullTypeNameWithoutModifiers(func->type()) << " > results;" << endl;
+            s << INDENT << "results.reserve(size);" << endl;
+        }
+        s << INDENT << '{' << endl;
+        {
+            Indentation indent(INDENT);
+            if (releaseGil) {
+                s << INDENT << "Shiboken::ThreadStateSaver " THREAD_STATE_SAVER_VAR ";" << endl;
+                s << INDENT << THREAD_STATE_SAVER_VAR ".save();" << endl;
+            }
+            s << INDENT << "for (Py_ssize_t i = 0; i < size; ++i)" << endl;
+            {
+                Indentation indent(INDENT);
+                if (func->type())
+                    s << INDENT << "results.push_back(" << call << ");" << endl;
+                else
+                    s << INDENT << call << ';' << endl;
+            }
+        }
+        s << INDENT << '}' << endl;
+        s << endl;
+
+        if (!func->type()) {
+            s << INDENT << "Py_RETURN_NONE;" << endl;
+        } else {
+            s << INDENT << "PyObject* " PYTHON_RETURN_VAR " = PyList_New(size);" << endl;
+            s << INDENT << "for (Py_ssize_t i = 0; i < size; ++i) {" << endl;
+            {
+                Indentation indent(INDENT);
+                s << INDENT << "PyObject* pyItem = ";
+                writeToPythonConversion(s, func->type(), metaClass, "results[i]");
+                s << ';' << endl;
+                s << INDENT << "if (!pyItem) {" << endl;
+                {
+                    Indentation indent(INDENT);
+                    s << INDENT << "Py_DECREF(" PYTHON_RETURN_VAR ");" << endl;
+                    s << INDENT << "return 0;" << endl;
+                }
+                s << INDENT << '}' << endl;
+                s << INDENT << "PyList_SET_ITEM(" PYTHON_RETURN_VAR ", i, pyItem);" << endl;
+            }
+            s << INDENT << '}' << endl;
+            s << INDENT << "return " PYTHON_RETURN_VAR ";" << endl;
+        }
+    }
+    s << '}' << endl << endl;
+}
+
+void CppGenerator::writeMapMethodDefinition(QTextStream& s, const AbstractMetaFunction* func)
+{
+    s << INDENT << "{\"" << func->name() << "_map\", (PyCFunction)" << cpythonFunctionName(func) << "_map, ";
+    s << "METH_O|METH_STATIC}," << endl;
+}
+
 void CppGenerator::writeEnumsInitialization(QTextStream& s, AbstractMetaEnumList& enums)
 {
     if (enums.isEmpty())
@@ -4490,21 +5131,33 @@ void CppGenerator::writeGetattroFunction(QTextStream& s, const AbstractMetaClass
                 s << INDENT << '}' << endl;
             }
             s << INDENT << '}' << endl;
-            s << INDENT << "// Search the method in the type dict" << endl;
+            s << INDENT << "// Search the method in the user type and its bases, through the type attribute cache" << endl;
             s << INDENT << "if (Shiboken::Object::isUserType(" PYTHON_SELF_VAR ")) {" << endl;
             {
                 Indentation indent(INDENT);
-                s << INDENT << "PyObject* meth = PyDict_GetItem(" PYTHON_SELF_VAR "->ob_type->tp_dict, name);" << endl;
-                s << INDENT << "if (meth)" << endl;
+                s << INDENT << "PyObject* meth = _PyType_Lookup(Py_TYPE(" PYTHON_SELF_VAR "), name);" << endl;
+                s << INDENT << "if (meth && PyFunction_Check(meth))" << endl;
                 {
                     Indentation indent(INDENT);
-                    s << INDENT << "return PyFunction_Check(meth) ? SBK_PyMethod_New(meth, " PYTHON_SELF_VAR ") : " << getattrFunc << ';' << endl;
+                    s << INDENT << "return SBK_PyMethod_New(meth, " PYTHON_SELF_VAR ");" << endl;
+                }
+                s << INDENT << "// Anything but the methods of the wrapped class is found as usual." << endl;
+                s << INDENT << "if (meth && meth != PyDict_GetItem(" << cpythonTypeNameExt(metaClass->typeEntry()) << "->tp_dict, name))" << endl;
+                {
+                    Indentation indent(INDENT);
+                    s << INDENT << "return " << getattrFunc << ';' << endl;
                 }
             }
             s << INDENT << '}' << endl;
 
+            // Attribute names are interned, so they are compared by identity.
             foreach (const AbstractMetaFunction* func, getMethodsWithBothStaticAndNonStaticMethods(metaClass)) {
-                s << INDENT << "if (Shiboken::String::compare(name, \"" << func->name() << "\") == 0)" << endl;
+                QString nameVar = staticStringReference(func->name());
+                if (nameVar.isEmpty()) {
+                    nameVar = QString("name_%1").arg(func->name());
+                    s << INDENT << "static PyObject* const " << nameVar << " = Shiboken::String::createStaticString(\"" << func->name() << "\");" << endl;
+                }
+                s << INDENT << "if (Shiboken::String::equalsStatic(name, " << nameVar << "))" << endl;
                 Indentation indent(INDENT);
                 s << INDENT << "return PyCFunction_NewEx(&" << cpythonMethodDefinitionName(func) << ", " PYTHON_SELF_VAR ", 0);" << endl;
             }
@@ -4630,6 +5283,17 @@ void CppGenerator::finishGeneration()
     s << "// Current module's converter array." << endl;
     s << "SbkConverter** " << convertersVariableName() << ';' << endl;
 
+    QStringList strings = staticStrings();
+    s << "// Current module's interned strings." << endl;
+    s << "PyObject** " << staticStringsVariableName() << ';' << endl;
+    if (!strings.isEmpty()) {
+        s << "static const char* " << staticStringsVariableName() << "_names[] = {" << endl;
+        foreach (const QString& str, strings)
+            s << "    \"" << str << "\"," << endl;
+        s << "    0" << endl;
+        s << "};" << endl;
+    }
+
     CodeSnipList snips;
     if (moduleEntry)
         snips = moduleEntry->codeSnips();
@@ -4792,6 +5456,16 @@ void CppGenerator::finishGeneration()
     s << INDENT << "// Create an array of primitive type converters for the current module." << endl;
     s << INDENT << "static SbkConverter* sbkConverters[SBK_" << moduleName() << "_CONVERTERS_IDX_COUNT" << "];" << endl;
     s << INDENT << convertersVariableName() << " = sbkConverters;" << endl << endl;
+    if (!strings.isEmpty()) {
+        s << INDENT << "// Create the interned strings used by the current module's generated code." << endl;
+        s << INDENT << "static PyObject* staticStrings[SBK_" << moduleName() << "_STR_IDX_COUNT];" << endl;
+        s << INDENT << "if (!Shiboken::String::createStaticStrings(staticStrings, " << staticStringsVariableName() << "_names))" << endl;
+        {
+            Indentation indentation(INDENT);
+            s << INDENT << "return SBK_MODULE_INIT_ERROR;" << endl;
+        }
+        s << INDENT << staticStringsVariableName() << " = staticStrings;" << endl << endl;
+    }
 
     s << "#ifdef IS_PY3K" << endl;
     s << INDENT << "PyObject* module = Shiboken::Module::create(\""  << moduleName() << "\", &moduledef);" << endl;
@@ -4840,12 +5514,20 @@ void CppGenerator::finishGeneration()
         if (!alias)
             continue;
         QString converter = converterObject(alias);
+        QStringList names;
         QStringList cppSignature = pte->qualifiedCppName().split("::", QString::SkipEmptyParts);
         while (!cppSignature.isEmpty()) {
-            QString signature = cppSignature.join("::");
-            s << INDENT << "Shiboken::Conversions::registerConverterName(" << converter << ", \"" << signature << "\");" << endl;
+            names << '"' + cppSignature.join("::") + '"';
             cppSignature.removeFirst();
         }
+        names << "0";
+        s << INDENT << "{" << endl;
+        {
+            Indentation indentation(INDENT);
+            s << INDENT << "static const char* converterNames[] = { " << names.join(", ") << " };" << endl;
+            s << INDENT << "Shiboken::Conversions::registerConverterNames(" << converter << ", converterNames);" << endl;
+        }
+        s << INDENT << "}" << endl;
     }
     // Register type resolver for all containers found in signals.
     QSet<QByteArray> typeResolvers;
@@ -4870,6 +5552,8 @@ void CppGenerator::finishGeneration()
     if (maxTypeIndex)
         s << INDENT << "Shiboken::Module::registerTypes(module, " << cppApiVariableName() << ");" << endl;
     s << INDENT << "Shiboken::Module::registerTypeConverters(module, " << convertersVariableName() << ");" << endl;
+    s << INDENT << "Shiboken::Module::exportCApi(module, \"" << packageName() << "._C_API\", ";
+    s << "SBK_" << moduleName() << "_IDX_COUNT, SBK_" << moduleName() << "_CONVERTERS_IDX_COUNT);" << endl;
 
     s << endl << INDENT << "if (PyErr_Occurred()) {" << endl;
     {
@@ -4999,12 +5683,63 @@ void CppGenerator::writeReturnValueHeuristics(QTextStream& s, const AbstractMeta
 void CppGenerator::writeHashFunction(QTextStream& s, const AbstractMetaClass* metaClass)
 {
     s << "static Py_hash_t " << cpythonBaseName(metaClass) << "_HashFunc(PyObject* self) {" << endl;
+    if (!isCachedHashType(metaClass)) {
+        writeCppSelfDefinition(s, metaClass);
+        s << INDENT << "return " << metaClass->typeEntry()->hashFunction() << '(';
+        s << (isObjectType(metaClass) ? "" : "*") << CPP_SELF_VAR << ");" << endl;
+        s << '}' << endl << endl;
+        return;
+    }
+    s << INDENT << "SbkObject* sbkSelf = reinterpret_cast<SbkObject*>(self);" << endl;
+    s << INDENT << "// C++ may change the objects Python doesn't own, including views borrowed from other objects." << endl;
+    s << INDENT << "bool cacheHash = Shiboken::Object::hasOwnership(sbkSelf) && !Shiboken::Object::isBorrowed(sbkSelf);" << endl;
+    s << INDENT << "Py_hash_t hash = cacheHash ? Shiboken::Object::cachedHash(sbkSelf) : -1;" << endl;
+    s << INDENT << "if (hash != -1)" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "return hash;" << endl;
+    }
     writeCppSelfDefinition(s, metaClass);
-    s << INDENT << "return " << metaClass->typeEntry()->hashFunction() << '(';
-    s << (isObjectType(metaClass) ? "" : "*") << CPP_SELF_VAR << ");" << endl;
+    s << INDENT << "hash = " << metaClass->typeEntry()->hashFunction() << "(*" CPP_SELF_VAR ");" << endl;
+    s << INDENT << "// -1 means an error for Python." << endl;
+    s << INDENT << "if (hash == -1)" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "hash = -2;" << endl;
+    }
+    s << INDENT << "if (cacheHash)" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "Shiboken::Object::setCachedHash(sbkSelf, hash);" << endl;
+    }
+    s << INDENT << "return hash;" << endl;
     s << '}' << endl << endl;
 }
 
+void CppGenerator::writeCachedHashReset(QTextStream& s, const OverloadData& overloadData)
+{
+    bool changesObject = false;
+    foreach (const AbstractMetaFunction* func, overloadData.overloads()) {
+        if (!func->isStatic() && !func->isConstant() && !func->isConstructor())
+            changesObject = true;
+    }
+    if (!changesObject)
+        return;
+    s << INDENT << "// Non-const methods may change the object hash." << endl;
+    if (overloadData.hasStaticFunction()) {
+        s << INDENT << "if (" PYTHON_SELF_VAR ")" << endl;
+        Indentation indent(INDENT);
+        writeCachedHashReset(s);
+    } else {
+        writeCachedHashReset(s);
+    }
+}
+
+void CppGenerator::writeCachedHashReset(QTextStream& s)
+{
+    s << INDENT << "Shiboken::Object::setCachedHash(reinterpret_cast<SbkObject*>(" PYTHON_SELF_VAR "), -1);" << endl;
+}
+
 void CppGenerator::writeStdListWrapperMethods(QTextStream& s, const AbstractMetaClass* metaClass)
 {
     ErrorCode errorCode(0);
@@ -5055,9 +5790,91 @@ void CppGenerator::writeStdListWrapperMethods(QTextStream& s, const AbstractMeta
     s << INDENT << metaClass->qualifiedCppName() << "::iterator _item = " CPP_SELF_VAR "->begin();" << endl;
     s << INDENT << "for (Py_ssize_t pos = 0; pos < _i; pos++) _item++;" << endl;
     s << INDENT << "*_item = cppValue;" << endl;
+    if (isCachedHashType(metaClass))
+        writeCachedHashReset(s);
     s << INDENT << "return 0;" << endl;
     s << '}' << endl;
 }
+
+QString CppGenerator::writeIteratorFunctions(QTextStream& s, const AbstractMetaClass* metaClass)
+{
+    ErrorCode errorCode(0);
+
+    QString baseName = cpythonBaseName(metaClass);
+    QString stateType = baseName + "_IteratorState";
+    QString nextFunc = baseName + "_IteratorNext";
+    QString deleteFunc = baseName + "_IteratorDelete";
+    QString funcName = baseName + "__iter__";
+    QString containerType = metaClass->qualifiedCppName();
+
+    // Containers are walked with their own iterators, other classes with the pointers returned by begin() and end().
+    QString sizeExpression;
+    QString itemDeclaration;
+    QString item = "(*item)";
+    const AbstractMetaType* itemType;
+    if (isContainerClass(metaClass)) {
+        itemType = metaClass->templateBaseClassInstantiations().first();
+        sizeExpression = "state->container->size()";
+        itemDeclaration = containerType + "::iterator item = state->container->begin();";
+    } else {
+        const AbstractMetaType* rangeType = metaClass->findFunction("begin")->type();
+        itemType = buildAbstractMetaTypeFromTypeEntry(rangeType->typeEntry());
+        sizeExpression = "state->container->end() - state->container->begin()";
+        itemDeclaration = rangeType->cppSignature() + " item = state->container->begin();";
+        if (isObjectType(itemType->typeEntry()))
+            item = "item";
+    }
+
+    // Only the position is kept between the steps: the C++ object may be changed while it is
+    // iterated, leaving a stored C++ iterator or pointer dangling.
+    s << "struct " << stateType << endl;
+    s << '{' << endl;
+    s << INDENT << containerType << "* container;" << endl;
+    s << INDENT << "std::size_t size;" << endl;
+    s << INDENT << "std::size_t position;" << endl;
+    s << "};" << endl << endl;
+
+    s << "static PyObject* " << nextFunc << "(void* statePtr)" << endl;
+    s << '{' << endl;
+    s << INDENT << stateType << "* state = reinterpret_cast<" << stateType << "*>(statePtr);" << endl;
+    s << INDENT << "std::size_t size = " << sizeExpression << ';' << endl;
+    s << INDENT << "if (size != state->size) {" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "PyErr_SetString(PyExc_RuntimeError, \"" << metaClass->name() << " changed size during iteration\");" << endl;
+        s << INDENT << "return 0;" << endl;
+    }
+    s << INDENT << '}' << endl;
+    s << INDENT << "if (state->position >= size)" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "return 0;" << endl;
+    }
+    s << INDENT << itemDeclaration << endl;
+    s << INDENT << "// Constant time for random access iterators, linear for the others." << endl;
+    s << INDENT << "std::advance(item, state->position++);" << endl;
+    s << INDENT << "return ";
+    writeToPythonConversion(s, itemType, metaClass, item);
+    s << ';' << endl;
+    s << '}' << endl << endl;
+
+    s << "static void " << deleteFunc << "(void* statePtr)" << endl;
+    s << '{' << endl;
+    s << INDENT << "delete reinterpret_cast<" << stateType << "*>(statePtr);" << endl;
+    s << '}' << endl << endl;
+
+    s << "static PyObject* " << funcName << "(PyObject* " PYTHON_SELF_VAR ")" << endl;
+    s << '{' << endl;
+    writeCppSelfDefinition(s, metaClass);
+    s << INDENT << stateType << "* state = new " << stateType << ';' << endl;
+    s << INDENT << "state->container = " CPP_SELF_VAR ";" << endl;
+    s << INDENT << "state->size = " << QString(sizeExpression).replace("state->container", CPP_SELF_VAR) << ';' << endl;
+    s << INDENT << "state->position = 0;" << endl;
+    s << INDENT << "return Shiboken::Iterator::create(" PYTHON_SELF_VAR ", state, " << nextFunc << ", " << deleteFunc << ");" << endl;
+    s << '}' << endl << endl;
+    return funcName;
+}
+
 void CppGenerator::writeIndexError(QTextStream& s, const QString& errorMsg)
 {
     s << INDENT << "if (_i < 0 || _i >= (Py_ssize_t) " CPP_SELF_VAR "->size()) {" << endl;
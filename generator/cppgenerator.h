@@ -47,6 +47,8 @@ private:
 
     QString getVirtualFunctionReturnTypeName(const AbstractMetaFunction* func);
     void writeVirtualMethodNative(QTextStream& s, const AbstractMetaFunction* func);
+    /// Writes the code queuing calls to the virtual method made by threads without the GIL.
+    void writeQueuedVirtualMethodCall(QTextStream& s, const AbstractMetaFunction* func);
 
     void writeMetaObjectMethod(QTextStream& s, const AbstractMetaClass* metaClass);
     void writeMetaCast(QTextStream& s, const AbstractMetaClass* metaClass);
@@ -65,6 +67,14 @@ private:
     void writeConstructorWrapper(QTextStream& s, const AbstractMetaFunctionList overloads);
     void writeDestructorWrapper(QTextStream& s, const AbstractMetaClass* metaClass);
     void writeMethodWrapper(QTextStream& s, const AbstractMetaFunctionList overloads);
+    /// Returns true if the method gets an "_async" variant, see ShibokenGenerator::generateAsyncMethods().
+    bool hasAsyncMethodWrapper(const AbstractMetaFunctionList overloads);
+    /// Writes the "_async" variant of a method, which calls it on libshiboken's thread pool.
+    void writeAsyncMethodWrapper(QTextStream& s, const AbstractMetaFunctionList overloads);
+    /// Returns true if the method gets a "_map" variant, see ShibokenGenerator::generateMapMethods().
+    bool hasMapMethodWrapper(const AbstractMetaFunctionList overloads);
+    /// Writes the "_map" variant of a method, which calls it in a C++ loop on the objects of a sequence.
+    void writeMapMethodWrapper(QTextStream& s, const AbstractMetaFunction* func);
     void writeArgumentsInitializer(QTextStream& s, OverloadData& overloadData);
     void writeCppSelfDefinition(QTextStream& s, const AbstractMetaFunction* func, bool hasStaticOverload = false);
     void writeCppSelfDefinition(QTextStream& s, const AbstractMetaClass* metaClass, bool hasStaticOverload = false, bool cppSelfAsReference = false);
@@ -74,6 +84,8 @@ private:
 
     /// Writes the check section for the validity of wrapped C++ objects.
     void writeInvalidPyObjectCheck(QTextStream& s, const QString& pyObj);
+    /// Writes the check refusing changes to read only views of C++ const objects.
+    void writeReadOnlyPyObjectCheck(QTextStream& s, const QString& pyObj);
 
     void writeTypeCheck(QTextStream& s, const AbstractMetaType* argType, QString argumentName, bool isNumber = false, QString customType = "", bool rejectNull = false);
     void writeTypeCheck(QTextStream& s, const OverloadData* overloadData, QString argumentName);
@@ -101,6 +113,15 @@ private:
                                  const QString& defaultValue = QString(),
                                  bool castArgumentAsUnused = false);
 
+    /**
+     *   Writes the conversion of a Python callable to the callback argument \p argName. The callable is
+     *   held by a Shiboken::PythonCallback named after the argument with the "_callback" suffix,
+     *   which also gives the removed user data argument; see isCallbackUserData().
+     */
+    void writeCallbackConversion(QTextStream& s, const AbstractMetaType* argType,
+                                 const QString& argName, const QString& pyArgName,
+                                 const QString& defaultValue);
+
     /**
      *  Returns the AbstractMetaType for a function argument.
      *  If the argument type was modified in the type system, this method will
@@ -203,12 +224,16 @@ private:
 
     /// Returns a string containing the name of an argument for the given function and argument index.
     QString argumentNameFromIndex(const AbstractMetaFunction* func, int argIndex, const AbstractMetaClass** wrappedClass);
+    /// Returns true if the value type reference returned by \p func is given to Python as a read only view.
+    bool returnsConstReferenceView(const AbstractMetaFunction* func);
     void writeMethodCall(QTextStream& s, const AbstractMetaFunction* func, int maxArgs = 0);
 
     void writeClassRegister(QTextStream& s, const AbstractMetaClass* metaClass);
     void writeClassDefinition(QTextStream& s, const AbstractMetaClass* metaClass);
     void writeMethodDefinitionEntry(QTextStream& s, const AbstractMetaFunctionList overloads);
     void writeMethodDefinition(QTextStream& s, const AbstractMetaFunctionList overloads);
+    void writeAsyncMethodDefinition(QTextStream& s, const AbstractMetaFunctionList overloads);
+    void writeMapMethodDefinition(QTextStream& s, const AbstractMetaFunction* func);
 
     /// Writes the implementation of all methods part of python sequence protocol
     void writeSequenceMethods(QTextStream& s, const AbstractMetaClass* metaClass);
@@ -229,6 +254,8 @@ private:
     void writeSetterFunction(QTextStream& s, const AbstractMetaField* metaField);
 
     void writeRichCompareFunction(QTextStream& s, const AbstractMetaClass* metaClass);
+    /// Writes the comparisons of objects of the exact same type, made without converting the other operand.
+    void writeRichCompareFastPath(QTextStream& s, const AbstractMetaClass* metaClass);
     void writeToPythonFunction(QTextStream& s, const AbstractMetaClass* metaClass);
 
     void writeEnumsInitialization(QTextStream& s, AbstractMetaEnumList& enums);
@@ -281,10 +308,17 @@ private:
     /// Returns true if the given class supports the python mapping protocol
     bool supportsMappingProtocol(const AbstractMetaClass* metaClass);
 
+    /// Returns true if the given class is a container or has begin() and end() methods returning pointers.
+    bool supportsIteratorProtocol(const AbstractMetaClass* metaClass);
+
     /// Returns true if generator should produce getters and setters for the given class.
     bool shouldGenerateGetSetList(const AbstractMetaClass* metaClass);
 
     void writeHashFunction(QTextStream& s, const AbstractMetaClass* metaClass);
+    /// Writes the code discarding the cached hash of an object changed by a non-const method.
+    void writeCachedHashReset(QTextStream& s, const OverloadData& overloadData);
+    /// Writes the code discarding the cached hash of the object given by PYTHON_SELF_VAR.
+    void writeCachedHashReset(QTextStream& s);
 
     /// Write default implementations for sequence protocol
     void writeStdListWrapperMethods(QTextStream& s, const AbstractMetaClass* metaClass);
@@ -293,6 +327,9 @@ private:
 
     QString writeReprFunction(QTextStream& s, const AbstractMetaClass* metaClass);
 
+    /// Writes a __iter__ function walking the C++ range of the given class, and returns its name.
+    QString writeIteratorFunctions(QTextStream& s, const AbstractMetaClass* metaClass);
+
     bool hasBoolCast(const AbstractMetaClass* metaClass) const;
 
     // Number protocol structure members names.
@@ -332,6 +332,15 @@ void HeaderGenerator::finishGeneration()
     macrosStream << endl;
     // TODO-CONVERTER ------------------------------------------------------------------------------
 
+    macrosStream << "// Static string indices" << endl;
+    QStringList strings = staticStrings();
+    for (int i = 0; i < strings.size(); ++i)
+        _writeTypeIndexDefineLine(macrosStream, getStaticStringIndexVariableName(strings.at(i)), i);
+    _writeTypeIndexDefineLine(macrosStream, QString("SBK_%1_STR_IDX_COUNT").arg(moduleName()), strings.size());
+    macrosStream << endl;
+    macrosStream << "// This variable stores the interned strings used by this module's generated code." << endl;
+    macrosStream << "extern PyObject** " << staticStringsVariableName() << ';' << endl << endl;
+
     macrosStream << "// Macros for type check" << endl;
     foreach (const AbstractMetaEnum* cppEnum, globalEnums) {
         if (cppEnum->isAnonymous() || cppEnum->isPrivate())
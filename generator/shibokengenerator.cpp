@@ -38,6 +38,13 @@
 #define ENABLE_PYSIDE_EXTENSIONS "enable-pyside-extensions"
 #define DISABLE_VERBOSE_ERROR_MESSAGES "disable-verbose-error-messages"
 #define USE_ISNULL_AS_NB_NONZERO "use-isnull-as-nb_nonzero"
+#define CONST_REFERENCE_VIEWS "enable-const-reference-views"
+#define AUTO_GIL_RELEASE "enable-auto-gil-release"
+#define ASYNC_METHODS "enable-async-methods"
+#define MAP_METHODS "enable-map-methods"
+#define QUEUED_VIRTUAL_METHODS "queued-virtual-methods"
+#define CACHE_HASH_TYPES "cache-hash-types"
+#define CALLBACK_TYPES "callback-types"
 
 //static void dumpFunction(AbstractMetaFunctionList lst);
 
@@ -249,6 +256,82 @@ bool ShibokenGenerator::shouldGenerateCppWrapper(const AbstractMetaClass* metaCl
     return result && !metaClass->isNamespace();
 }
 
+bool ShibokenGenerator::isGilReleaseEligible(const AbstractMetaFunction* func) const
+{
+    if (func->hasInjectedCode())
+        return false;
+    const AbstractMetaClass* ownerClass = func->ownerClass();
+    if (ownerClass && !func->isStatic() && shouldGenerateCppWrapper(ownerClass))
+        return false;
+    foreach (const AbstractMetaArgument* arg, func->arguments()) {
+        if (func->argumentRemoved(arg->argumentIndex() + 1))
+            continue;
+        if (!func->typeReplaced(arg->argumentIndex() + 1).isEmpty())
+            return false;
+        const AbstractMetaType* type = arg->type();
+        if (type->typeEntry()->isCustom() || type->typeEntry()->name() == "PyObject")
+            return false;
+        if (!isWrapperType(type))
+            continue;
+        if (!type->isConstant() && (type->isReference() || type->indirections() > 0))
+            return false;
+        const AbstractMetaClass* argClass = classes().findClass(type->typeEntry());
+        if (!argClass || shouldGenerateCppWrapper(argClass))
+            return false;
+    }
+    return true;
+}
+
+bool ShibokenGenerator::isCachedHashType(const AbstractMetaClass* metaClass) const
+{
+    if (m_cachedHashTypes.isEmpty())
+        return false;
+    if (metaClass->typeEntry()->isValue() && m_cachedHashTypes.contains(metaClass->qualifiedCppName()))
+        return true;
+    foreach (const AbstractMetaClass* ancestor, getAllAncestors(metaClass)) {
+        if (ancestor->typeEntry()->isValue() && m_cachedHashTypes.contains(ancestor->qualifiedCppName()))
+            return true;
+    }
+    return false;
+}
+
+bool ShibokenGenerator::isQueuedVirtualMethod(const AbstractMetaFunction* func) const
+{
+    if (m_queuedVirtualMethods.isEmpty() || func->type() || func->hasInjectedCode())
+        return false;
+    const AbstractMetaClass* declaringClass = func->declaringClass();
+    if (!declaringClass || !m_queuedVirtualMethods.contains(declaringClass->qualifiedCppName() + "::" + func->name()))
+        return false;
+    // The arguments are copied to the queue.
+    foreach (const AbstractMetaArgument* arg, func->arguments()) {
+        const AbstractMetaType* type = arg->type();
+        if (type->indirections() > 0 || type->isNativePointer() || (type->isReference() && !type->isConstant())
+            || type->typeEntry()->isCustom() || type->typeEntry()->isObject())
+            return false;
+    }
+    return true;
+}
+
+bool ShibokenGenerator::isCallbackType(const AbstractMetaType* type) const
+{
+    return !m_callbackTypes.isEmpty() && type->typeEntry()->isPrimitive() && type->indirections() == 0
+           && !type->isReference() && m_callbackTypes.contains(type->typeEntry()->qualifiedCppName());
+}
+
+bool ShibokenGenerator::isCallbackUserData(const AbstractMetaFunction* func, int argIndex) const
+{
+    if (m_callbackTypes.isEmpty() || argIndex < 1 || argIndex >= func->arguments().size()
+        || func->isUserAdded() || func->hasInjectedCode() || !func->argumentRemoved(argIndex + 1))
+        return false;
+    if (!isVoidPointer(func->arguments().at(argIndex)->type()))
+        return false;
+    // The callback, converted from a Python callable, is the previous argument.
+    const AbstractMetaType* callbackType = func->arguments().at(argIndex - 1)->type();
+    return isCallbackType(callbackType) && !func->argumentRemoved(argIndex)
+           && func->typeReplaced(argIndex).isEmpty()
+           && func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty();
+}
+
 void ShibokenGenerator::lookForEnumsInClassesNotToBeGenerated(AbstractMetaEnumList& enumList, const AbstractMetaClass* metaClass)
 {
     if (!metaClass)
@@ -966,7 +1049,7 @@ QString ShibokenGenerator::cpythonCheckFunction(const AbstractMetaType* metaType
 
     if (isCppPrimitive(metaType)) {
         if (isCString(metaType))
-            return "Shiboken::String::check";
+            return "Shiboken::String::checkCharBuffer";
         if (isVoidPointer(metaType))
             return "PyObject_Check";
         return cpythonCheckFunction(metaType->typeEntry(), genericNumberType);
@@ -980,13 +1063,15 @@ QString ShibokenGenerator::cpythonCheckFunction(const AbstractMetaType* metaType
             || type == ContainerTypeEntry::StackContainer
             || type == ContainerTypeEntry::SetContainer
             || type == ContainerTypeEntry::QueueContainer) {
+            // Sets are built from any iterable, Python sets included.
+            QString kind = (type == ContainerTypeEntry::SetContainer) ? "Iterable" : "Sequence";
             const AbstractMetaType* type = metaType->instantiations().first();
             if (isPointerToWrapperType(type))
-                typeCheck += QString("checkSequenceTypes(%1, ").arg(cpythonTypeNameExt(type));
+                typeCheck += QString("check%1Types(%2, ").arg(kind).arg(cpythonTypeNameExt(type));
             else if (isWrapperType(type))
-                typeCheck += QString("convertibleSequenceTypes((SbkObjectType*)%1, ").arg(cpythonTypeNameExt(type));
+                typeCheck += QString("convertible%1Types((SbkObjectType*)%2, ").arg(kind).arg(cpythonTypeNameExt(type));
             else
-                typeCheck += QString("convertibleSequenceTypes(%1, ").arg(converterObject(type));
+                typeCheck += QString("convertible%1Types(%2, ").arg(kind).arg(converterObject(type));
         } else if (type == ContainerTypeEntry::MapContainer
             || type == ContainerTypeEntry::MultiMapContainer
             || type == ContainerTypeEntry::HashContainer
@@ -2210,6 +2295,13 @@ QMap<QString, QString> ShibokenGenerator::options() const
     opts.insert(ENABLE_PYSIDE_EXTENSIONS, "Enable PySide extensions, such as support for signal/slots, use this if you are creating a binding for a Qt-based library.");
     opts.insert(DISABLE_VERBOSE_ERROR_MESSAGES, "Disable verbose error messages. Turn the python code hard to debug but safe few kB on the generated bindings.");
     opts.insert(USE_ISNULL_AS_NB_NONZERO, "If a class have an isNull()const method, it will be used to compute the value of boolean casts");
+    opts.insert(CONST_REFERENCE_VIEWS, "Return read only views of the C++ objects instead of copies for const value type fields and const references returned by methods.");
+    opts.insert(ASYNC_METHODS, "Generate an \"_async\" variant, returning a future, for every method marked with allow-thread.");
+    opts.insert(MAP_METHODS, "Generate a static \"_map\" variant, calling the method on every object of a sequence, for methods without arguments returning values.");
+    opts.insert(QUEUED_VIRTUAL_METHODS, "Comma separated list of void virtual methods, as in \"Class::method\", whose calls from threads unknown to Python are queued instead of waiting for the GIL.");
+    opts.insert(CACHE_HASH_TYPES, "Comma separated list of value types whose wrappers cache their hash values, discarded when the objects are changed from Python.");
+    opts.insert(CALLBACK_TYPES, "Comma separated list of function pointer types, taking user data as their last void* argument, whose arguments accept Python callables when the user data argument that follows is removed.");
+    opts.insert(AUTO_GIL_RELEASE, "Release the GIL only around calls that can't get back to Python and take long enough on average, or are marked with allow-thread.");
     return opts;
 }
 
@@ -2246,6 +2338,13 @@ bool ShibokenGenerator::doSetup(const QMap<QString, QString>& args)
     m_verboseErrorMessagesDisabled = args.contains(DISABLE_VERBOSE_ERROR_MESSAGES);
     m_useIsNullAsNbNonZero = args.contains(USE_ISNULL_AS_NB_NONZERO);
     m_avoidProtectedHack = args.contains(AVOID_PROTECTED_HACK);
+    m_useConstReferenceViews = args.contains(CONST_REFERENCE_VIEWS);
+    m_useAutoGilRelease = args.contains(AUTO_GIL_RELEASE);
+    m_generateAsyncMethods = args.contains(ASYNC_METHODS);
+    m_generateMapMethods = args.contains(MAP_METHODS);
+    m_queuedVirtualMethods = args.value(QUEUED_VIRTUAL_METHODS).split(',', QString::SkipEmptyParts);
+    m_cachedHashTypes = args.value(CACHE_HASH_TYPES).split(',', QString::SkipEmptyParts);
+    m_callbackTypes = args.value(CALLBACK_TYPES).split(',', QString::SkipEmptyParts);
 
     TypeDatabase* td = TypeDatabase::instance();
     QStringList snips;
@@ -2311,6 +2410,26 @@ bool ShibokenGenerator::avoidProtectedHack() const
     return m_avoidProtectedHack;
 }
 
+bool ShibokenGenerator::useConstReferenceViews() const
+{
+    return m_useConstReferenceViews;
+}
+
+bool ShibokenGenerator::useAutoGilRelease() const
+{
+    return m_useAutoGilRelease;
+}
+
+bool ShibokenGenerator::generateAsyncMethods() const
+{
+    return m_generateAsyncMethods;
+}
+
+bool ShibokenGenerator::generateMapMethods() const
+{
+    return m_generateMapMethods;
+}
+
 QString ShibokenGenerator::cppApiVariableName(const QString& moduleName) const
 {
     QString result = moduleName.isEmpty() ? ShibokenGenerator::packageName() : moduleName;
@@ -2328,6 +2447,62 @@ QString ShibokenGenerator::convertersVariableName(const QString& moduleName) con
     return result;
 }
 
+QString ShibokenGenerator::staticStringsVariableName() const
+{
+    QString result = cppApiVariableName();
+    result.chop(5);
+    result.append("StaticStrings");
+    return result;
+}
+
+QStringList ShibokenGenerator::staticStrings()
+{
+    if (!m_staticStrings.isEmpty())
+        return m_staticStrings;
+
+    QSet<QString> names;
+    foreach (const AbstractMetaClass* metaClass, classes()) {
+        if (!shouldGenerate(metaClass))
+            continue;
+        bool hasWrapper = shouldGenerateCppWrapper(metaClass);
+        foreach (const AbstractMetaFunction* func, metaClass->functions()) {
+            if (hasWrapper && func->isVirtual())
+                names << (func->isOperatorOverload() ? pythonOperatorFunctionName(func) : func->name());
+            foreach (const AbstractMetaArgument* arg, OverloadData::getArgumentsWithDefaultValues(func))
+                names << arg->name();
+        }
+        foreach (const AbstractMetaFunction* func, getMethodsWithBothStaticAndNonStaticMethods(metaClass))
+            names << func->name();
+    }
+    foreach (AbstractMetaFunctionList globalOverloads, getFunctionGroups().values()) {
+        foreach (const AbstractMetaFunction* func, globalOverloads) {
+            foreach (const AbstractMetaArgument* arg, OverloadData::getArgumentsWithDefaultValues(func))
+                names << arg->name();
+        }
+    }
+
+    // Only names that can be part of an index variable name make it to the table.
+    QRegExp identifier("^[A-Za-z_][A-Za-z0-9_]*$");
+    foreach (const QString& name, names) {
+        if (identifier.exactMatch(name))
+            m_staticStrings << name;
+    }
+    qSort(m_staticStrings);
+    return m_staticStrings;
+}
+
+QString ShibokenGenerator::staticStringReference(const QString& str)
+{
+    if (!staticStrings().contains(str))
+        return QString();
+    return QString("%1[%2]").arg(staticStringsVariableName()).arg(getStaticStringIndexVariableName(str));
+}
+
+QString ShibokenGenerator::getStaticStringIndexVariableName(const QString& str) const
+{
+    return QString("SBK_%1_STR_%2_IDX").arg(moduleName()).arg(str);
+}
+
 static QString processInstantiationsVariableName(const AbstractMetaType* type)
 {
     QString res = QString("_%1").arg(_fixedCppTypeName(type->typeEntry()->qualifiedCppName()).toUpper());
@@ -259,6 +259,36 @@ public:
     /// Verifies if the class should have a C++ wrapper generated for it, instead of only a Python wrapper.
     bool shouldGenerateCppWrapper(const AbstractMetaClass* metaClass) const;
 
+    /**
+     *  Returns true if a call to the C++ function can't get back to Python, i.e. it can't reach
+     *  virtual methods reimplemented in Python, receives no Python objects or callbacks, has no
+     *  injected code and can't modify wrapped objects given as arguments.
+     *  The GIL may then be released automatically around the call.
+     */
+    bool isGilReleaseEligible(const AbstractMetaFunction* func) const;
+
+    /**
+     *  Returns true if the class, or one of its ancestors, was listed with the "cache-hash-types"
+     *  option. The hash values of such objects are cached, and discarded when they are changed from Python.
+     */
+    bool isCachedHashType(const AbstractMetaClass* metaClass) const;
+
+    /**
+     *  Returns true if calls to the virtual method made by threads unknown to Python are queued,
+     *  to run later on a thread holding it. Only void methods listed with the "queued-virtual-methods"
+     *  option that take their arguments by value or const reference are queued.
+     */
+    bool isQueuedVirtualMethod(const AbstractMetaFunction* func) const;
+
+    /// Returns true if \p type is a function pointer type listed with the "callback-types" option.
+    bool isCallbackType(const AbstractMetaType* type) const;
+
+    /**
+     *  Returns true if the argument at the zero based \p argIndex is a removed void* following a
+     *  callback type argument. It receives the user data of the callback made from a Python callable.
+     */
+    bool isCallbackUserData(const AbstractMetaFunction* func, int argIndex) const;
+
     /// Adds enums eligible for generation from classes/namespaces marked not to be generated.
     static void lookForEnumsInClassesNotToBeGenerated(AbstractMetaEnumList& enumList, const AbstractMetaClass* metaClass);
     /// Returns the enclosing class for an enum, or NULL if it should be global.
@@ -423,8 +453,31 @@ public:
     bool useIsNullAsNbNonZero() const;
     /// Returns true if the generated code should use the "#define protected public" hack.
     bool avoidProtectedHack() const;
+    /// Returns true if const value type fields and references should be returned as read only views.
+    bool useConstReferenceViews() const;
+    /// Returns true if the GIL should be released according to the calls' durations, for eligible functions.
+    bool useAutoGilRelease() const;
+    /// Returns true if methods marked with allow-thread should get an "_async" variant.
+    bool generateAsyncMethods() const;
+    /// Returns true if methods without arguments returning values should get a "_map" variant.
+    bool generateMapMethods() const;
     QString cppApiVariableName(const QString& moduleName = QString()) const;
     QString convertersVariableName(const QString& moduleName = QString()) const;
+    /// Returns the name of the variable holding the current module's table of interned strings.
+    QString staticStringsVariableName() const;
+    /**
+     *  Returns the names used by the generated code for dictionary and attribute lookups,
+     *  i.e. virtual method names, keyword argument names and attribute names checked by
+     *  getattro functions. They are interned once at module initialization.
+     */
+    QStringList staticStrings();
+    /**
+     *  Returns the expression referring to the interned string \p str in the current module's
+     *  table, or an empty string if \p str isn't part of it.
+     */
+    QString staticStringReference(const QString& str);
+    /// Returns the index variable name of the string \p str in the current module's string table.
+    QString getStaticStringIndexVariableName(const QString& str) const;
     /**
      *  Returns the type index variable name for a given class. If \p alternativeTemplateName is true
      *  and the class is a typedef for a template class instantiation, it will return an alternative name
@@ -524,10 +577,19 @@ private:
     bool m_verboseErrorMessagesDisabled;
     bool m_useIsNullAsNbNonZero;
     bool m_avoidProtectedHack;
+    bool m_useConstReferenceViews;
+    bool m_useAutoGilRelease;
+    bool m_generateAsyncMethods;
+    bool m_generateMapMethods;
+    QStringList m_queuedVirtualMethods;
+    QStringList m_cachedHashTypes;
+    QStringList m_callbackTypes;
 
     typedef QHash<QString, AbstractMetaType*> AbstractMetaTypeCache;
     AbstractMetaTypeCache m_metaTypeFromStringCache;
 
+    QStringList m_staticStrings;
+
     /// Type system converter variable replacement names and regular expressions.
     QString m_typeSystemConvName[TypeSystemConverterVariables];
     QRegExp m_typeSystemConvRegEx[TypeSystemConverterVariables];
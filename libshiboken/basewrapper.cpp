@@ -24,6 +24,9 @@
 #include "basewrapper_p.h"
 #include "sbkconverter.h"
 #include "sbkenum.h"
+#include "shibokenbuffer.h"
+#include "sbkcontainerview.h"
+#include "sbkiterator.h"
 #include "autodecref.h"
 #include "typeresolver.h"
 #include "gilstate.h"
@@ -34,6 +37,8 @@
 #include <sstream>
 #include <algorithm>
 #include "threadstatesaver.h"
+#include <pythread.h>
+#include <list>
 
 namespace {
     void _destroyParentInfo(SbkObject* obj, bool keepReference);
@@ -209,6 +214,12 @@ void SbkDeallocWrapper(PyObject* pyObj)
     if (sbkObj->weakreflist)
         PyObject_ClearWeakRefs(pyObj);
 
+    // The C++ object was already deleted by another thread, only the wrapper cleanup is left.
+    if (Shiboken::Object::cancelDeferredDestruction(sbkObj)) {
+        Shiboken::Object::deallocData(sbkObj, true);
+        return;
+    }
+
     // If I have ownership and is valid delete C++ pointer
     if (sbkObj->d->hasOwnership && sbkObj->d->validCppObject) {
         SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(pyObj->ob_type);
@@ -217,8 +228,14 @@ void SbkDeallocWrapper(PyObject* pyObj)
             Shiboken::walkThroughClassHierarchy(pyObj->ob_type, &visitor);
         } else {
             void* cptr = sbkObj->d->cptr[0];
+            // The destructor of a C++ wrapper (shell) class calls back into libshiboken, so it is
+            // never run on the background thread.
+            bool background = sbkType->d->background_dtor && !sbkObj->d->containsCppWrapper;
             Shiboken::Object::deallocData(sbkObj, true);
 
+            if (background && Shiboken::queueBackgroundDestruction(cptr, sbkType->d->cpp_dtor))
+                return;
+
             Shiboken::ThreadStateSaver threadSaver;
             if (Py_IsInitialized())
                 threadSaver.save();
@@ -235,6 +252,7 @@ void SbkDeallocWrapperWithPrivateDtor(PyObject* self)
     if (sbkObj->weakreflist)
         PyObject_ClearWeakRefs(self);
 
+    Shiboken::Object::cancelDeferredDestruction(sbkObj);
     Shiboken::Object::deallocData(sbkObj, true);
 }
 
@@ -302,6 +320,7 @@ PyObject* SbkObjectTypeTpNew(PyTypeObject* metatype, PyObject* args, PyObject* k
         d->mi_specialcast = parentType->mi_specialcast;
         d->type_discovery = parentType->type_discovery;
         d->cpp_dtor = parentType->cpp_dtor;
+        d->background_dtor = parentType->background_dtor;
         d->is_multicpp = 0;
         d->converter = parentType->converter;
     } else {
@@ -346,6 +365,13 @@ PyObject* SbkObjectTpNew(PyTypeObject* subtype, PyObject*, PyObject*)
     d->parentInfo = 0;
     d->referredObjects = 0;
     d->cppObjectCreated = 0;
+    d->readOnly = 0;
+    d->borrowed = 0;
+    d->pendingDestruction = 0;
+    d->holder = 0;
+    d->holderType = 0;
+    d->holderDeleter = 0;
+    d->cachedHash = -1;
     self->ob_dict = 0;
     self->weakreflist = 0;
     self->d = d;
@@ -461,6 +487,144 @@ void DeallocVisitor::done()
     DtorCallerVisitor::done();
 }
 
+// Background destruction ------------------------------------------------------------------
+
+typedef std::list<std::pair<void*, ObjectDestructor> > DestructionQueue;
+static DestructionQueue destructionQueue;
+static unsigned int destructionQueueSize = 0;
+static unsigned int maxDestructionQueueSize = 256;
+// Protects the queue and the flags below.
+static PyThread_type_lock destructionQueueLock = 0;
+// Released to wake up the background thread when objects are queued.
+static PyThread_type_lock destructionQueueSignal = 0;
+static bool destructionQueueSignaled = false;
+// Held by whichever thread is deleting queued objects.
+static PyThread_type_lock destructionBusyLock = 0;
+
+// Deletes the queued objects until the queue is empty. Must be called without the GIL.
+static void processDestructionQueue()
+{
+    PyThread_acquire_lock(destructionBusyLock, WAIT_LOCK);
+    for (;;) {
+        PyThread_acquire_lock(destructionQueueLock, WAIT_LOCK);
+        if (destructionQueue.empty()) {
+            PyThread_release_lock(destructionQueueLock);
+            break;
+        }
+        std::pair<void*, ObjectDestructor> item = destructionQueue.front();
+        destructionQueue.pop_front();
+        destructionQueueSize--;
+        PyThread_release_lock(destructionQueueLock);
+        item.second(item.first);
+    }
+    PyThread_release_lock(destructionBusyLock);
+}
+
+static void destructionThread(void*)
+{
+    for (;;) {
+        PyThread_acquire_lock(destructionQueueSignal, WAIT_LOCK);
+        PyThread_acquire_lock(destructionQueueLock, WAIT_LOCK);
+        destructionQueueSignaled = false;
+        PyThread_release_lock(destructionQueueLock);
+        processDestructionQueue();
+    }
+}
+
+static PyObject* flushBackgroundDestructionsAtExit(PyObject*, PyObject*)
+{
+    flushBackgroundDestructions();
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef flushBackgroundDestructionsDef = {
+    "flushBackgroundDestructions", (PyCFunction)flushBackgroundDestructionsAtExit, METH_NOARGS, 0
+};
+
+// Registers the final flush with the atexit module, so that it runs while the interpreter
+// is still alive: after finalization the background thread can't be waited for safely.
+static void registerAtExitFlush()
+{
+    AutoDecRef atexitModule(PyImport_ImportModule("atexit"));
+    AutoDecRef flushFunction(PyCFunction_New(&flushBackgroundDestructionsDef, 0));
+    if (atexitModule.isNull() || flushFunction.isNull()
+        || AutoDecRef(PyObject_CallMethod(atexitModule, const_cast<char*>("register"),
+                                          const_cast<char*>("O"), flushFunction.object())).isNull()) {
+        PyErr_Clear();
+    }
+}
+
+static void freeLock(PyThread_type_lock lock)
+{
+    if (lock)
+        PyThread_free_lock(lock);
+}
+
+static bool startDestructionThread()
+{
+    if (destructionQueueLock)
+        return true;
+    PyThread_type_lock signal = PyThread_allocate_lock();
+    PyThread_type_lock busyLock = PyThread_allocate_lock();
+    PyThread_type_lock queueLock = PyThread_allocate_lock();
+    bool started = signal && busyLock && queueLock;
+    if (started) {
+        PyThread_acquire_lock(signal, WAIT_LOCK);
+        destructionQueueSignal = signal;
+        destructionBusyLock = busyLock;
+        started = PyThread_start_new_thread(&destructionThread, 0) != SBK_INVALID_THREAD_ID;
+        if (!started) {
+            PyThread_release_lock(signal);
+            destructionQueueSignal = 0;
+            destructionBusyLock = 0;
+        }
+    }
+    if (!started) {
+        freeLock(signal);
+        freeLock(busyLock);
+        freeLock(queueLock);
+        return false;
+    }
+    destructionQueueLock = queueLock;
+    registerAtExitFlush();
+    return true;
+}
+
+bool queueBackgroundDestruction(void* cptr, ObjectDestructor dtor)
+{
+    // Called with the GIL held, so the thread is started only once.
+    if (!startDestructionThread())
+        return false;
+
+    PyThread_acquire_lock(destructionQueueLock, WAIT_LOCK);
+    bool queued = destructionQueueSize < maxDestructionQueueSize;
+    if (queued) {
+        destructionQueue.push_back(std::make_pair(cptr, dtor));
+        destructionQueueSize++;
+        if (!destructionQueueSignaled) {
+            destructionQueueSignaled = true;
+            PyThread_release_lock(destructionQueueSignal);
+        }
+    }
+    PyThread_release_lock(destructionQueueLock);
+    return queued;
+}
+
+void setBackgroundDestructionQueueSize(unsigned int size)
+{
+    maxDestructionQueueSize = size;
+}
+
+void flushBackgroundDestructions()
+{
+    if (!destructionQueueLock)
+        return;
+    Shiboken::ThreadStateSaver threadSaver;
+    if (Py_IsInitialized())
+        threadSaver.save();
+    processDestructionQueue();
+}
+
 namespace Module { void init(); }
 namespace Conversions { void init(); }
 
@@ -488,6 +652,18 @@ void init()
     if (PyType_Ready((PyTypeObject *)&SbkObject_Type) < 0)
         Py_FatalError("[libshiboken] Failed to initialise Shiboken.BaseWrapper type.");
 
+    if (PyType_Ready(&SbkBuffer_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.Buffer type.");
+
+    if (PyType_Ready(&SbkSequenceView_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.SequenceView type.");
+
+    if (PyType_Ready(&SbkMappingView_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.MappingView type.");
+
+    if (PyType_Ready(&SbkIterator_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.Iterator type.");
+
     shibokenAlreadInitialised = true;
 }
 
@@ -673,6 +849,11 @@ void setDestructorFunction(SbkObjectType* self, ObjectDestructor func)
     self->d->cpp_dtor = func;
 }
 
+void setBackgroundDestruction(SbkObjectType* self, bool enabled)
+{
+    self->d->background_dtor = enabled;
+}
+
 void initPrivateData(SbkObjectType* self)
 {
     self->d = new SbkObjectTypePrivate;
@@ -784,8 +965,21 @@ bool wasCreatedByPython(SbkObject* pyObj)
 
 void callCppDestructors(SbkObject* pyObj)
 {
+    // The C++ object was already deleted by another thread.
+    if (isDestructionPending(pyObj)) {
+        processDeferredDestructions();
+        return;
+    }
+
     SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(Py_TYPE(pyObj));
-    if (sbkType->d->is_multicpp) {
+    if (pyObj->d->holder) {
+        // The C++ object is shared with smart pointers, only the wrapper's share is released.
+        void* holder = pyObj->d->holder;
+        pyObj->d->holder = 0;
+        Shiboken::ThreadStateSaver threadSaver;
+        threadSaver.save();
+        pyObj->d->holderDeleter(holder);
+    } else if (sbkType->d->is_multicpp) {
         Shiboken::DtorCallerVisitor visitor(pyObj);
         Shiboken::walkThroughClassHierarchy(Py_TYPE(pyObj), &visitor);
     } else {
@@ -813,6 +1007,10 @@ void getOwnership(SbkObject* self)
     if (self->d->parentInfo && self->d->parentInfo->parent)
         return;
 
+    // skip if the object is shared with smart pointers, they keep the ownership
+    if (self->d->holder)
+        return;
+
     // Get back the ownership
     self->d->hasOwnership = true;
 
@@ -835,6 +1033,10 @@ void releaseOwnership(SbkObject* self)
     if (!self->d->hasOwnership || Shiboken::Conversions::pythonTypeIsValueType(selfType->d->converter))
         return;
 
+    // skip if the object is shared with smart pointers, they keep the ownership
+    if (self->d->holder)
+        return;
+
     // remove object ownership
     self->d->hasOwnership = false;
 
@@ -988,7 +1190,7 @@ bool isValid(PyObject* pyObj)
         return false;
     }
 
-    if (!priv->validCppObject) {
+    if (!priv->validCppObject || isDestructionPending(reinterpret_cast<SbkObject*>(pyObj))) {
         PyErr_Format(PyExc_RuntimeError, "Internal C++ object (%s) already deleted.", pyObj->ob_type->tp_name);
         return false;
     }
@@ -996,6 +1198,17 @@ bool isValid(PyObject* pyObj)
     return true;
 }
 
+bool isWritable(PyObject* pyObj)
+{
+    if (!isValid(pyObj))
+        return false;
+    if (Object::checkType(pyObj) && reinterpret_cast<SbkObject*>(pyObj)->d->readOnly) {
+        PyErr_Format(PyExc_TypeError, "'%s' object is a read only view of a C++ const object.", Py_TYPE(pyObj)->tp_name);
+        return false;
+    }
+    return true;
+}
+
 bool isValid(SbkObject* pyObj, bool throwPyError)
 {
     if (!pyObj)
@@ -1008,7 +1221,7 @@ bool isValid(SbkObject* pyObj, bool throwPyError)
         return false;
     }
 
-    if (!priv->validCppObject) {
+    if (!priv->validCppObject || isDestructionPending(pyObj)) {
         if (throwPyError)
             PyErr_Format(PyExc_RuntimeError, "Internal C++ object (%s) already deleted.", Py_TYPE(pyObj)->tp_name);
         return false;
@@ -1052,17 +1265,148 @@ PyObject* newObject(SbkObjectType* instanceType,
     return reinterpret_cast<PyObject*>(self);
 }
 
+PyObject* borrowedObject(PyObject* owner, SbkObjectType* instanceType, const void* cptr, bool readOnly)
+{
+    SbkObject* owner_ = reinterpret_cast<SbkObject*>(owner);
+    void* cppIn = const_cast<void*>(cptr);
+
+    // A reference to the owner itself.
+    if (Py_TYPE(owner) == reinterpret_cast<PyTypeObject*>(instanceType) && owner_->d->cptr[0] == cppIn) {
+        Py_INCREF(owner);
+        return owner;
+    }
+
+    std::pair<const void*, PyTypeObject*> key(cptr, reinterpret_cast<PyTypeObject*>(instanceType));
+    if (owner_->d->parentInfo) {
+        BorrowedChildrenMap& borrowed = owner_->d->parentInfo->borrowedChildren;
+        BorrowedChildrenMap::iterator it = borrowed.find(key);
+        if (it != borrowed.end()) {
+            SbkObject* child = it->second;
+            // Entries of children moved to another parent since are dropped by removeParent.
+            if (child->d->validCppObject && !child->d->hasOwnership && child->d->readOnly == readOnly) {
+                Py_INCREF(reinterpret_cast<PyObject*>(child));
+                return reinterpret_cast<PyObject*>(child);
+            }
+        }
+    }
+
+    PyObject* pyOut = newObject(instanceType, cppIn, false, true);
+    reinterpret_cast<SbkObject*>(pyOut)->d->readOnly = readOnly;
+    reinterpret_cast<SbkObject*>(pyOut)->d->borrowed = 1;
+    setParent(owner, pyOut);
+    if (owner_->d->parentInfo)
+        owner_->d->parentInfo->borrowedChildren[key] = reinterpret_cast<SbkObject*>(pyOut);
+    return pyOut;
+}
+
+bool isBorrowed(SbkObject* pyObj)
+{
+    return pyObj->d->borrowed;
+}
+
 void destroy(SbkObject* self)
 {
     destroy(self, 0);
 }
 
+typedef std::list<std::pair<SbkObject*, void*> > DeferredDestructionList;
+static bool deferredDestructionEnabled = false;
+static PyThread_type_lock deferredDestructionLock = 0;
+static DeferredDestructionList deferredDestructions;
+static bool deferredDestructionScheduled = false;
+
+static int processDeferredDestructionsCallback(void*)
+{
+    processDeferredDestructions();
+    return 0;
+}
+
+// Called without the GIL: only touches the wrapper's pending flag and the queue, both under its lock.
+static void deferDestruction(SbkObject* self, void* cppData)
+{
+    PyThread_acquire_lock(deferredDestructionLock, WAIT_LOCK);
+    self->d->pendingDestruction = 1;
+    deferredDestructions.push_back(std::make_pair(self, cppData));
+    if (!deferredDestructionScheduled)
+        deferredDestructionScheduled = Py_AddPendingCall(&processDeferredDestructionsCallback, 0) == 0;
+    PyThread_release_lock(deferredDestructionLock);
+}
+
+void setDeferredDestruction(bool enabled)
+{
+    if (enabled && !deferredDestructionLock)
+        deferredDestructionLock = PyThread_allocate_lock();
+    if (enabled)
+        BindingManager::instance().setThreadSafe();
+    deferredDestructionEnabled = enabled && deferredDestructionLock;
+}
+
+void processDeferredDestructions()
+{
+    if (!deferredDestructionLock)
+        return;
+
+    // Entries are taken one at a time: destroying one wrapper can run Python code that deallocates
+    // another queued wrapper, which must then find its entry still in the queue to cancel it.
+    while (true) {
+        PyThread_acquire_lock(deferredDestructionLock, WAIT_LOCK);
+        if (deferredDestructions.empty()) {
+            deferredDestructionScheduled = false;
+            PyThread_release_lock(deferredDestructionLock);
+            return;
+        }
+        std::pair<SbkObject*, void*> entry = deferredDestructions.front();
+        deferredDestructions.pop_front();
+        entry.first->d->pendingDestruction = 0;
+        PyThread_release_lock(deferredDestructionLock);
+
+        destroy(entry.first, entry.second);
+    }
+}
+
+bool isDestructionPending(SbkObject* self)
+{
+    if (!deferredDestructionLock)
+        return false;
+    PyThread_acquire_lock(deferredDestructionLock, WAIT_LOCK);
+    bool pending = self->d->pendingDestruction;
+    PyThread_release_lock(deferredDestructionLock);
+    return pending;
+}
+
+bool cancelDeferredDestruction(SbkObject* self)
+{
+    if (!deferredDestructionLock)
+        return false;
+    bool found = false;
+    PyThread_acquire_lock(deferredDestructionLock, WAIT_LOCK);
+    if (self->d->pendingDestruction) {
+        for (DeferredDestructionList::iterator it = deferredDestructions.begin(); it != deferredDestructions.end(); ++it) {
+            if (it->first == self) {
+                deferredDestructions.erase(it);
+                found = true;
+                break;
+            }
+        }
+        self->d->pendingDestruction = 0;
+    }
+    PyThread_release_lock(deferredDestructionLock);
+    return found;
+}
+
 void destroy(SbkObject* self, void* cppData)
 {
     // Skip if this is called with NULL pointer this can happen in derived classes
     if (!self)
         return;
 
+    // Threads with a Python thread state, even when they released the GIL around a C++ call,
+    // can take it back; only foreign threads, e.g. C++ worker threads, defer the cleanup.
+    if (deferredDestructionEnabled && Py_IsInitialized() && !PyGILState_GetThisThreadState()) {
+        deferDestruction(self, cppData);
+        return;
+    }
+
     // This can be called in c++ side
     Shiboken::GilState gil;
 
@@ -1119,6 +1463,14 @@ void removeParent(SbkObject* child, bool giveOwnershipBack, bool keepReference)
 
     oldBrothers.erase(iChild);
 
+    BorrowedChildrenMap& borrowed = pInfo->parent->d->parentInfo->borrowedChildren;
+    if (!borrowed.empty() && child->d->cptr) {
+        BorrowedChildrenMap::iterator iBorrowed = borrowed.find(std::make_pair(const_cast<const void*>(child->d->cptr[0]),
+                                                                              Py_TYPE(child)));
+        if (iBorrowed != borrowed.end() && iBorrowed->second == child)
+            borrowed.erase(iBorrowed);
+    }
+
     pInfo->parent = 0;
 
     // This will keep the wrapper reference, will wait for wrapper destruction to remove that
@@ -1163,6 +1515,10 @@ void setParent(PyObject* parent, PyObject* child)
     SbkObject* parent_ = reinterpret_cast<SbkObject*>(parent);
     SbkObject* child_ = reinterpret_cast<SbkObject*>(child);
 
+    // An object shared with smart pointers is deleted by them, never by a parent.
+    if (child_->d->holder)
+        return;
+
     if (!parentIsNull) {
         if (!parent_->d->parentInfo)
             parent_->d->parentInfo = new ParentInfo;
@@ -1214,15 +1570,56 @@ void deallocData(SbkObject* self, bool cleanup)
         clearReferences(self);
     }
 
+    void* holder = 0;
+    void (*holderDeleter)(void*) = 0;
     if (self->d->cptr) {
         // Remove from BindingManager
         Shiboken::BindingManager::instance().releaseWrapper(self);
         delete[] self->d->cptr;
         self->d->cptr = 0;
+        holder = self->d->holder;
+        holderDeleter = self->d->holderDeleter;
         delete self->d;
     }
     Py_XDECREF(self->ob_dict);
     Py_TYPE(self)->tp_free(self);
+
+    // Releasing the smart pointer may delete the C++ object, as a C++ destructor call would.
+    if (holder) {
+        Shiboken::ThreadStateSaver threadSaver;
+        if (Py_IsInitialized())
+            threadSaver.save();
+        holderDeleter(holder);
+    }
+}
+
+void setHolder(SbkObject* self, void* holder, const char* holderType, DeleteUserDataFunc deleter)
+{
+    if (self->d->holder)
+        self->d->holderDeleter(self->d->holder);
+    self->d->holder = holder;
+    self->d->holderType = holderType;
+    self->d->holderDeleter = deleter;
+    // The smart pointer shares the C++ object ownership from now on.
+    if (holder)
+        self->d->hasOwnership = false;
+}
+
+void* holder(SbkObject* self, const char* holderType)
+{
+    if (!self->d->holder || std::strcmp(self->d->holderType, holderType) != 0)
+        return 0;
+    return self->d->holder;
+}
+
+Py_hash_t cachedHash(SbkObject* self)
+{
+    return self->d->cachedHash;
+}
+
+void setCachedHash(SbkObject* self, Py_hash_t hash)
+{
+    self->d->cachedHash = hash;
 }
 
 void setTypeUserData(SbkObject* wrapper, void* userData, DeleteUserDataFunc d_func)
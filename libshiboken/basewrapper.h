@@ -108,6 +108,20 @@ void callCppDestructor(void* cptr)
     delete reinterpret_cast<T*>(cptr);
 }
 
+/**
+ *  Sets the maximum number of C++ objects waiting in the background destruction queue,
+ *  256 by default. Objects released while the queue is full are deleted right away.
+ *  \see ObjectType::setBackgroundDestruction
+ */
+LIBSHIBOKEN_API void        setBackgroundDestructionQueueSize(unsigned int size);
+
+/**
+ *  Deletes the C++ objects still waiting in the background destruction queue and waits for the
+ *  one being deleted by the background thread, if any. Called automatically by an atexit
+ *  handler, while the interpreter is still alive.
+ */
+LIBSHIBOKEN_API void        flushBackgroundDestructions();
+
 /**
  *  Shiboken::importModule is DEPRECATED. Use Shiboken::Module::import() instead.
  */
@@ -170,6 +184,17 @@ LIBSHIBOKEN_API MultipleInheritanceInitFunction getMultipleIheritanceFunction(Sb
 
 LIBSHIBOKEN_API void        setDestructorFunction(SbkObjectType* self, ObjectDestructor func);
 
+/**
+ *  When enabled, C++ objects owned by wrappers of type \p self, or of Python types derived
+ *  from it afterwards, are deleted by a background thread, without the GIL, once their wrappers
+ *  are deallocated. Meant for types with expensive destructors that must not stall Python.
+ *  Objects created from Python as instances of a C++ wrapper (shell) class, generated for types
+ *  with virtual methods, are still deleted right away: their destructors call back into
+ *  libshiboken, which needs the GIL.
+ *  \see flushBackgroundDestructions
+ */
+LIBSHIBOKEN_API void        setBackgroundDestruction(SbkObjectType* self, bool enabled);
+
 LIBSHIBOKEN_API void        initPrivateData(SbkObjectType* self);
 
 /**
@@ -245,6 +270,24 @@ LIBSHIBOKEN_API PyObject*   newObject(SbkObjectType* instanceType,
                                       bool isExactType = false,
                                       const char* typeName = 0);
 
+/**
+ *  Returns a wrapper for \p cptr, a C++ object stored inside the one wrapped by \p owner, like
+ *  one of its fields or the target of a reference returned by one of its methods.
+ *  The wrapper doesn't own \p cptr and is made a child of \p owner, so it is reused by later calls
+ *  with the same \p cptr and \p instanceType for as long as \p owner lives, and is invalidated with it.
+ * \param readOnly if true, the wrapper refuses calls to non const methods and field assignments
+ *                 (see isWritable).
+ */
+LIBSHIBOKEN_API PyObject*   borrowedObject(PyObject* owner,
+                                           SbkObjectType* instanceType,
+                                           const void* cptr,
+                                           bool readOnly = false);
+
+/**
+ *  Returns true if \p pyObj was created by borrowedObject, so its C++ object belongs to another one.
+ */
+LIBSHIBOKEN_API bool        isBorrowed(SbkObject* pyObj);
+
 /**
  *  Changes the valid flag of a PyObject, invalid objects will raise an exception when someone tries to access it.
  */
@@ -340,6 +383,12 @@ LIBSHIBOKEN_API bool        isValid(SbkObject* pyObj, bool throwPyError = true);
  */
 LIBSHIBOKEN_API bool        isValid(PyObject* pyObj, bool throwPyError);
 
+/**
+ * Returns false and sets a Python exception if the Python wrapper is not valid, or is a
+ * read only view created by borrowedObject.
+ */
+LIBSHIBOKEN_API bool        isWritable(PyObject* pyObj);
+
 /**
 *   Set the parent of \p child to \p parent.
 *   When an object dies, all their children, grandchildren, etc, are tagged as invalid.
@@ -383,6 +432,50 @@ SBK_DEPRECATED(LIBSHIBOKEN_API void destroy(SbkObject* self));
  */
 LIBSHIBOKEN_API void        destroy(SbkObject* self, void* cppData);
 
+/**
+ * Enables or disables the deferred destruction of wrappers, disabled by default.
+ * When enabled, destroy() called by a thread unknown to Python, e.g. when a C++ worker thread
+ * deletes an object created from Python, only marks the wrapper as invalid and queues the rest
+ * of the cleanup, instead of waiting for the GIL. The queue is processed by the interpreter as
+ * a pending call or by processDeferredDestructions(). A queued wrapper deallocated before that
+ * is just removed from the queue, its C++ object being already deleted.
+ */
+LIBSHIBOKEN_API void        setDeferredDestruction(bool enabled);
+
+/**
+ * Finishes the destruction of the wrappers queued by destroy() in deferred mode.
+ * Must be called with the GIL held.
+ */
+LIBSHIBOKEN_API void        processDeferredDestructions();
+
+/**
+ *  Makes \p holder, a smart pointer to the C++ object wrapped by \p self, be kept by the wrapper
+ *  and deleted by \p deleter when the wrapper dies. Python stops owning the C++ object, whose
+ *  lifetime is managed by the smart pointers from now on. A previous holder is deleted.
+ *  While the holder is set getOwnership(), releaseOwnership() and setParent() leave the object
+ *  alone: its ownership isn't taken back by Python, nor given to C++ or to a parent wrapper.
+ *  \param holderType name of the smart pointer type, checked by holder()
+ *  \see sbksmartpointer.h
+ */
+LIBSHIBOKEN_API void        setHolder(SbkObject* self, void* holder, const char* holderType, DeleteUserDataFunc deleter);
+
+/**
+ *  Returns the smart pointer kept by \p self if its type is \p holderType, or 0 otherwise.
+ */
+LIBSHIBOKEN_API void*       holder(SbkObject* self, const char* holderType);
+
+/**
+ *  Returns the hash value cached for \p self, or -1 if there is none.
+ */
+LIBSHIBOKEN_API Py_hash_t   cachedHash(SbkObject* self);
+
+/**
+ *  Caches the hash value of \p self, used by the hash functions of the types listed with --cache-hash-types.
+ *  Setting it to -1 discards the cached value. Those hash functions only cache the values of objects
+ *  owned by Python and not borrowed from other objects, since C++ doesn't change those.
+ */
+LIBSHIBOKEN_API void        setCachedHash(SbkObject* self, Py_hash_t hash);
+
 /**
  *  Set user data on type of \p wrapper.
  *  \param wrapper instance object, the user data will be set on his type
@@ -44,6 +44,9 @@ typedef std::map<std::string, std::list<PyObject*> > RefCountMap;
 /// Linked list of SbkBaseWrapper pointers
 typedef std::set<SbkObject*> ChildrenList;
 
+/// Children created by Object::borrowedObject, indexed by their C++ address and Python type.
+typedef std::map<std::pair<const void*, PyTypeObject*>, SbkObject*> BorrowedChildrenMap;
+
 /// Structure used to store information about object parent and children.
 struct ParentInfo
 {
@@ -53,6 +56,8 @@ struct ParentInfo
     SbkObject* parent;
     /// List of object children.
     ChildrenList children;
+    /// Borrowed wrappers among the children, for lookup by Object::borrowedObject.
+    BorrowedChildrenMap borrowedChildren;
     /// has internal ref
     bool hasWrapperRef;
 };
@@ -78,10 +83,24 @@ struct SbkObjectPrivate
     unsigned int validCppObject : 1;
     /// Marked as true when the object constructor was called
     unsigned int cppObjectCreated : 1;
+    /// Marked as true for views of C++ const objects, that must not be modified from Python.
+    unsigned int readOnly : 1;
+    /// Marked as true for wrappers created by Object::borrowedObject, whose C++ objects belong to other objects.
+    unsigned int borrowed : 1;
     /// Information about the object parents and children, may be null.
     Shiboken::ParentInfo* parentInfo;
     /// Manage reference count of objects that are referred to but not owned from.
     Shiboken::RefCountMap* referredObjects;
+    /// Set, possibly by a thread without the GIL, when the C++ object was deleted and the rest of the wrapper cleanup was deferred.
+    volatile int pendingDestruction;
+    /// Smart pointer sharing the ownership of the C++ object, deleted with the wrapper; may be null.
+    void* holder;
+    /// Name of the smart pointer type, used to check the holder type when reading it.
+    const char* holderType;
+    /// Deletes the smart pointer.
+    void (*holderDeleter)(void*);
+    /// Cached hash value of the object, or -1 when not computed yet.
+    Py_hash_t cachedHash;
 
     ~SbkObjectPrivate()
     {
@@ -118,6 +137,8 @@ struct SbkObjectTypePrivate
     /// Tells is the type is a value type or an object-type, see BEHAVIOUR_* constants.
     // TODO-CONVERTERS: to be deprecated/removed
     int type_behaviour : 2;
+    /// True if the C++ instances are deleted by the background destruction thread.
+    unsigned int background_dtor : 1;
     /// C++ name
     char* original_name;
     /// Type user data
@@ -131,6 +152,27 @@ struct SbkObjectTypePrivate
 
 namespace Shiboken
 {
+/**
+ * Queues \p cptr to be deleted with \p dtor by the background destruction thread.
+ * Returns false if the queue is full or the thread couldn't be started.
+ **/
+bool queueBackgroundDestruction(void* cptr, ObjectDestructor dtor);
+
+namespace Object
+{
+/**
+ * Returns true if the cleanup of \p self was deferred by destroy() and is still queued.
+ * The flag is read under the queue lock, since threads without the GIL set it.
+ **/
+bool isDestructionPending(SbkObject* self);
+
+/**
+ * Removes \p self from the queue of deferred destructions, returning false if it wasn't queued.
+ * Used when the wrapper is deallocated before the queue is processed. Needs the GIL.
+ **/
+bool cancelDeferredDestruction(SbkObject* self);
+} // namespace Object
+
 /**
  * Utility function used to transform a PyObject that implements sequence protocol into a std::list.
  **/
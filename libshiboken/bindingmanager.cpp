@@ -27,9 +27,11 @@
 #include "sbkdbg.h"
 #include "gilstate.h"
 #include "sbkstring.h"
+#include "autodecref.h"
 
 #include <cstddef>
 #include <fstream>
+#include <pythread.h>
 
 
 namespace Shiboken
@@ -119,30 +121,55 @@ static void showWrapperMap(const WrapperMap& wrapperMap)
 }
 #endif
 
+// Holds the wrapper map lock, if any, for the lifetime of the scope.
+class WrapperMapLocker
+{
+public:
+    explicit WrapperMapLocker(PyThread_type_lock lock) : m_lock(lock)
+    {
+        if (m_lock)
+            PyThread_acquire_lock(m_lock, WAIT_LOCK);
+    }
+    ~WrapperMapLocker()
+    {
+        if (m_lock)
+            PyThread_release_lock(m_lock);
+    }
+private:
+    PyThread_type_lock m_lock;
+};
+
 struct BindingManager::BindingManagerPrivate {
     WrapperMap wrapperMapper;
+    // Only allocated when the wrapper map is accessed without the GIL, see setThreadSafe().
+    PyThread_type_lock wrapperMapLock;
     Graph classHierarchy;
     bool destroying;
 
-    BindingManagerPrivate() : destroying(false) {}
-    void releaseWrapper(void* cptr);
+    BindingManagerPrivate() : wrapperMapLock(0), destroying(false) {}
+    void releaseWrapper(void* cptr, SbkObject* wrapper);
     void assignWrapper(SbkObject* wrapper, const void* cptr);
 
 };
 
-void BindingManager::BindingManagerPrivate::releaseWrapper(void* cptr)
+void BindingManager::BindingManagerPrivate::releaseWrapper(void* cptr, SbkObject* wrapper)
 {
+    WrapperMapLocker locker(wrapperMapLock);
     WrapperMap::iterator iter = wrapperMapper.find(cptr);
-    if (iter != wrapperMapper.end())
+    // The address may be in use by a new object if the wrapper destruction was deferred.
+    if (iter != wrapperMapper.end() && iter->second == wrapper)
         wrapperMapper.erase(iter);
 }
 
 void BindingManager::BindingManagerPrivate::assignWrapper(SbkObject* wrapper, const void* cptr)
 {
     assert(cptr);
+    WrapperMapLocker locker(wrapperMapLock);
     WrapperMap::iterator iter = wrapperMapper.find(cptr);
     if (iter == wrapperMapper.end())
         wrapperMapper.insert(std::make_pair(cptr, wrapper));
+    else if (Object::isDestructionPending(iter->second))
+        iter->second = wrapper;
 }
 
 BindingManager::BindingManager()
@@ -164,6 +191,8 @@ BindingManager::~BindingManager()
         Object::destroy(m_d->wrapperMapper.begin()->second, const_cast<void*>(m_d->wrapperMapper.begin()->first));
     }
     assert(m_d->wrapperMapper.size() == 0);
+    if (m_d->wrapperMapLock)
+        PyThread_free_lock(m_d->wrapperMapLock);
     delete m_d;
 }
 
@@ -172,8 +201,15 @@ BindingManager& BindingManager::instance() {
     return singleton;
 }
 
+void BindingManager::setThreadSafe()
+{
+    if (!m_d->wrapperMapLock)
+        m_d->wrapperMapLock = PyThread_allocate_lock();
+}
+
 bool BindingManager::hasWrapper(const void* cptr)
 {
+    WrapperMapLocker locker(m_d->wrapperMapLock);
     return m_d->wrapperMapper.find(cptr) != m_d->wrapperMapper.end();
 }
 
@@ -207,12 +243,12 @@ void BindingManager::releaseWrapper(SbkObject* sbkObj)
     void** cptrs = reinterpret_cast<SbkObject*>(sbkObj)->d->cptr;
     for (int i = 0; i < numBases; ++i) {
         void* cptr = cptrs[i];
-        m_d->releaseWrapper(cptr);
+        m_d->releaseWrapper(cptr, sbkObj);
         if (d && d->mi_offsets) {
             int* offset = d->mi_offsets;
             while (*offset != -1) {
                 if (*offset > 0)
-                    m_d->releaseWrapper((void*) ((std::size_t) cptr + (*offset)));
+                    m_d->releaseWrapper((void*) ((std::size_t) cptr + (*offset)), sbkObj);
                 offset++;
             }
         }
@@ -222,13 +258,26 @@ void BindingManager::releaseWrapper(SbkObject* sbkObj)
 
 SbkObject* BindingManager::retrieveWrapper(const void* cptr)
 {
+    WrapperMapLocker locker(m_d->wrapperMapLock);
     WrapperMap::iterator iter = m_d->wrapperMapper.find(cptr);
-    if (iter == m_d->wrapperMapper.end())
+    if (iter == m_d->wrapperMapper.end() || Object::isDestructionPending(iter->second))
         return 0;
     return iter->second;
 }
 
 PyObject* BindingManager::getOverride(const void* cptr, const char* methodName)
+{
+    SbkObject* wrapper = retrieveWrapper(cptr);
+    // The refcount can be 0 if the object is dieing and someone called
+    // a virtual method from the destructor
+    if (!wrapper || ((PyObject*)wrapper)->ob_refcnt == 0)
+        return 0;
+
+    AutoDecRef pyMethodName(Shiboken::String::fromCString(methodName));
+    return getOverride(cptr, pyMethodName);
+}
+
+PyObject* BindingManager::getOverride(const void* cptr, PyObject* pyMethodName)
 {
     SbkObject* wrapper = retrieveWrapper(cptr);
     // The refcount can be 0 if the object is dieing and someone called
@@ -237,14 +286,13 @@ PyObject* BindingManager::getOverride(const void* cptr, const char* methodName)
         return 0;
 
     if (wrapper->ob_dict) {
-        PyObject* method = PyDict_GetItemString(wrapper->ob_dict, methodName);
+        PyObject* method = PyDict_GetItem(wrapper->ob_dict, pyMethodName);
         if (method) {
             Py_INCREF((PyObject*)method);
             return method;
         }
     }
 
-    PyObject* pyMethodName = Shiboken::String::fromCString(methodName);
     PyObject* method = PyObject_GetAttr((PyObject*)wrapper, pyMethodName);
 
     if (method && PyMethod_Check(method)
@@ -258,16 +306,13 @@ PyObject* BindingManager::getOverride(const void* cptr, const char* methodName)
             PyTypeObject* parent = reinterpret_cast<PyTypeObject*>(PyTuple_GET_ITEM(mro, i));
             if (parent->tp_dict) {
                 defaultMethod = PyDict_GetItem(parent->tp_dict, pyMethodName);
-                if (defaultMethod && reinterpret_cast<PyMethodObject*>(method)->im_func != defaultMethod) {
-                    Py_DECREF(pyMethodName);
+                if (defaultMethod && reinterpret_cast<PyMethodObject*>(method)->im_func != defaultMethod)
                     return method;
-                }
             }
         }
     }
 
     Py_XDECREF(method);
-    Py_DECREF(pyMethodName);
     return 0;
 }
 
@@ -290,6 +335,7 @@ SbkObjectType* BindingManager::resolveType(void** cptr, SbkObjectType* type)
 std::set<PyObject*> BindingManager::getAllPyObjects()
 {
     std::set<PyObject*> pyObjects;
+    WrapperMapLocker locker(m_d->wrapperMapLock);
     const WrapperMap& wrappersMap = m_d->wrapperMapper;
     WrapperMap::const_iterator it = wrappersMap.begin();
     for (; it != wrappersMap.end(); ++it)
@@ -300,7 +346,11 @@ std::set<PyObject*> BindingManager::getAllPyObjects()
 
 void BindingManager::visitAllPyObjects(ObjectVisitor visitor, void* data)
 {
-    WrapperMap copy = m_d->wrapperMapper;
+    WrapperMap copy;
+    {
+        WrapperMapLocker locker(m_d->wrapperMapLock);
+        copy = m_d->wrapperMapper;
+    }
     for (WrapperMap::iterator it = copy.begin(); it != copy.end(); ++it) {
         if (hasWrapper(it->first))
             visitor(it->second, data);
@@ -40,6 +40,14 @@ class LIBSHIBOKEN_API BindingManager
 public:
     static BindingManager& instance();
 
+    /**
+     * Guards the wrapper map with a lock, so that wrappers can be registered, released and
+     * retrieved by threads that don't hold the GIL, e.g. by the destructor of a C++ wrapper
+     * class run in a C++ worker thread when the deferred destruction is enabled.
+     * The lock is kept once allocated.
+     */
+    void setThreadSafe();
+
     bool hasWrapper(const void *cptr);
 
     void registerWrapper(SbkObject* pyObj, void* cptr);
@@ -47,6 +55,8 @@ public:
 
     SbkObject* retrieveWrapper(const void* cptr);
     PyObject* getOverride(const void* cptr, const char* methodName);
+    /// Same as the above, but takes the method name as a Python string, preferably an interned one.
+    PyObject* getOverride(const void* cptr, PyObject* methodName);
 
     void addClassInheritance(SbkObjectType* parent, SbkObjectType* child);
     /**
@@ -22,15 +22,52 @@
 
 #include "gilstate.h"
 
+#if defined(_MSC_VER)
+    #define SBK_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+    #define SBK_THREAD_LOCAL __thread
+#endif
+
+// Reads the current thread state without the checks done by debug builds of Python.
+#if PY_VERSION_HEX >= 0x03050200
+    #define SBK_CURRENT_THREAD_STATE() _PyThreadState_UncheckedGet()
+#elif !defined(Py_DEBUG)
+    #define SBK_CURRENT_THREAD_STATE() PyThreadState_GET()
+#endif
+
+#if defined(SBK_THREAD_LOCAL) && defined(SBK_CURRENT_THREAD_STATE)
+    #define SBK_TRACK_GIL_DEPTH
+#endif
+
 namespace Shiboken
 {
 
+#ifdef SBK_TRACK_GIL_DEPTH
+// Number of GilState objects holding the GIL in the current thread, and the thread state
+// the outermost one acquired. The thread state is checked too, since code other than
+// ThreadStateSaver, e.g. Py_BEGIN_ALLOW_THREADS in injected code, may release the GIL.
+static SBK_THREAD_LOCAL int gilDepth = 0;
+static SBK_THREAD_LOCAL PyThreadState* gilThreadState = 0;
+#endif
+
 GilState::GilState()
-    : m_locked(false)
+    : m_locked(false), m_nested(false)
 {
+#ifdef SBK_TRACK_GIL_DEPTH
+    if (gilDepth > 0 && SBK_CURRENT_THREAD_STATE() == gilThreadState) {
+        ++gilDepth;
+        m_locked = true;
+        m_nested = true;
+        return;
+    }
+#endif
     if (Py_IsInitialized()) {
         m_gstate = PyGILState_Ensure();
         m_locked = true;
+#ifdef SBK_TRACK_GIL_DEPTH
+        if (gilDepth++ == 0)
+            gilThreadState = SBK_CURRENT_THREAD_STATE();
+#endif
     }
 }
 
@@ -41,10 +78,44 @@ GilState::~GilState()
 
 void GilState::release()
 {
-    if (m_locked && Py_IsInitialized()) {
+    if (!m_locked)
+        return;
+#ifdef SBK_TRACK_GIL_DEPTH
+    --gilDepth;
+#endif
+    if (!m_nested && Py_IsInitialized())
         PyGILState_Release(m_gstate);
-        m_locked = false;
-    }
+    m_locked = false;
+}
+
+int GilState::suspend()
+{
+#ifdef SBK_TRACK_GIL_DEPTH
+    int depth = gilDepth;
+    gilDepth = 0;
+    return depth;
+#else
+    return 0;
+#endif
+}
+
+void GilState::resume(int depth)
+{
+#ifdef SBK_TRACK_GIL_DEPTH
+    gilDepth = depth;
+#endif
+}
+
+bool currentThreadMayHoldGil()
+{
+#if PY_VERSION_HEX >= 0x03040000
+    return PyGILState_Check();
+#elif PY_VERSION_HEX >= 0x03030000
+    return true;
+#else
+    PyThreadState* threadState = PyGILState_GetThisThreadState();
+    return threadState && threadState == _PyThreadState_Current;
+#endif
 }
 
 } // namespace Shiboken
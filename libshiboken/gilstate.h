@@ -29,6 +29,12 @@
 namespace Shiboken
 {
 
+/**
+ *  Makes sure the current thread holds the GIL while the object is alive.
+ *  Nested GilState objects in a thread already holding the GIL through an outer
+ *  GilState just increment a thread local counter instead of calling
+ *  PyGILState_Ensure again.
+ */
 class LIBSHIBOKEN_API GilState
 {
 public:
@@ -38,8 +44,18 @@ public:
 private:
     PyGILState_STATE m_gstate;
     bool m_locked;
+    bool m_nested;
+
+    friend class ThreadStateSaver;
+    /// Returns how many GilState objects hold the GIL in the current thread, and resets the count.
+    static int suspend();
+    /// Restores the count of GilState objects returned by suspend().
+    static void resume(int depth);
 };
 
+/// Returns false if the current thread doesn't hold the GIL, true if it does or if that can't be known.
+LIBSHIBOKEN_API bool currentThreadMayHoldGil();
+
 } // namespace Shiboken
 
 #endif // GILSTATE_H
@@ -0,0 +1,250 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "sbkasync.h"
+#include "autodecref.h"
+#include "gilstate.h"
+#include <pythread.h>
+#include <list>
+
+namespace Shiboken
+{
+namespace Async
+{
+
+struct Job
+{
+    PyObject* callable;
+    PyObject* args;
+    PyObject* kwds;
+    PyObject* future;
+    /// Event loop owning the future, or NULL for a concurrent.futures.Future.
+    PyObject* loop;
+};
+
+static int threadCount = 4;
+static std::list<Job*> jobs;
+// Protects the job list and the flag below.
+static PyThread_type_lock jobsLock = 0;
+// Released to wake up one of the pool threads when there are jobs.
+static PyThread_type_lock jobsSignal = 0;
+static bool jobsSignaled = false;
+
+// Sets the result of an asyncio future, unless it was cancelled. Runs in the loop's thread.
+static PyObject* resolveFuture(PyObject*, PyObject* args)
+{
+    PyObject* future;
+    PyObject* method;
+    PyObject* value;
+    if (!PyArg_ParseTuple(args, "OOO", &future, &method, &value))
+        return 0;
+    AutoDecRef cancelled(PyObject_CallMethod(future, const_cast<char*>("cancelled"), 0));
+    if (cancelled.isNull())
+        return 0;
+    if (PyObject_IsTrue(cancelled))
+        Py_RETURN_NONE;
+    return PyObject_CallFunctionObjArgs(method, value, 0);
+}
+
+static PyMethodDef resolveFutureDef = { "resolveFuture", (PyCFunction)resolveFuture, METH_VARARGS, 0 };
+
+// Hands the result, or the exception, of a job to its future. Called with the GIL held.
+static void finishJob(Job* job, PyObject* result)
+{
+    PyObject* type = 0;
+    PyObject* value = 0;
+    PyObject* traceback = 0;
+    if (!result) {
+        PyErr_Fetch(&type, &value, &traceback);
+        PyErr_NormalizeException(&type, &value, &traceback);
+    }
+    const char* methodName = result ? "set_result" : "set_exception";
+    AutoDecRef method(PyObject_GetAttrString(job->future, methodName));
+    PyObject* arg = result ? result : value;
+    if (!method.isNull()) {
+        PyObject* ret;
+        if (job->loop) {
+            AutoDecRef resolve(PyCFunction_New(&resolveFutureDef, 0));
+            ret = PyObject_CallMethod(job->loop, const_cast<char*>("call_soon_threadsafe"), const_cast<char*>("OOOO"),
+                                      resolve.object(), job->future, method.object(), arg ? arg : Py_None);
+        } else {
+            ret = PyObject_CallFunctionObjArgs(method, arg ? arg : Py_None, 0);
+        }
+        Py_XDECREF(ret);
+    }
+    // Nobody is waiting on this thread for errors, e.g. when the loop was closed meanwhile.
+    if (PyErr_Occurred())
+        PyErr_Print();
+    Py_XDECREF(result);
+    Py_XDECREF(type);
+    Py_XDECREF(value);
+    Py_XDECREF(traceback);
+}
+
+static void runJob(Job* job)
+{
+    GilState gil;
+    bool run = true;
+    if (!job->loop) {
+        AutoDecRef running(PyObject_CallMethod(job->future, const_cast<char*>("set_running_or_notify_cancel"), 0));
+        run = !running.isNull() && PyObject_IsTrue(running);
+        PyErr_Clear();
+    }
+    if (run)
+        finishJob(job, PyObject_Call(job->callable, job->args, job->kwds));
+    Py_DECREF(job->callable);
+    Py_DECREF(job->args);
+    Py_XDECREF(job->kwds);
+    Py_DECREF(job->future);
+    Py_XDECREF(job->loop);
+    delete job;
+}
+
+static void poolThread(void*)
+{
+    for (;;) {
+        PyThread_acquire_lock(jobsSignal, WAIT_LOCK);
+        PyThread_acquire_lock(jobsLock, WAIT_LOCK);
+        Job* job = jobs.front();
+        jobs.pop_front();
+        // Passes the signal on to another thread if there is more work.
+        if (jobs.empty())
+            jobsSignaled = false;
+        else
+            PyThread_release_lock(jobsSignal);
+        PyThread_release_lock(jobsLock);
+        runJob(job);
+    }
+}
+
+static bool startPool()
+{
+    if (jobsLock)
+        return true;
+    PyEval_InitThreads();
+    PyThread_type_lock signal = PyThread_allocate_lock();
+    PyThread_type_lock lock = PyThread_allocate_lock();
+    if (!signal || !lock) {
+        if (signal)
+            PyThread_free_lock(signal);
+        if (lock)
+            PyThread_free_lock(lock);
+        PyErr_SetString(PyExc_RuntimeError, "Could not create the thread pool locks.");
+        return false;
+    }
+    PyThread_acquire_lock(signal, WAIT_LOCK);
+    jobsSignal = signal;
+    // The pool works with fewer threads than requested, but not without any.
+    int started = 0;
+    for (int i = 0; i < threadCount; ++i) {
+        if (PyThread_start_new_thread(&poolThread, 0) != SBK_INVALID_THREAD_ID)
+            ++started;
+    }
+    if (!started) {
+        jobsSignal = 0;
+        PyThread_release_lock(signal);
+        PyThread_free_lock(signal);
+        PyThread_free_lock(lock);
+        PyErr_SetString(PyExc_RuntimeError, "Could not start the thread pool.");
+        return false;
+    }
+    jobsLock = lock;
+    return true;
+}
+
+// Returns the asyncio event loop running in the current thread, or NULL.
+static PyObject* runningLoop()
+{
+    PyObject* asyncio = PyDict_GetItemString(PyImport_GetModuleDict(), "asyncio");
+    if (!asyncio)
+        return 0;
+    // get_running_loop() raises when no loop is running. Python 3.5 and 3.6 only have the
+    // helper it wraps, which returns None instead; get_event_loop() can't replace them, as it
+    // creates a loop when there is none.
+    const char* getter = PyObject_HasAttrString(asyncio, "get_running_loop") ? "get_running_loop" : "_get_running_loop";
+    PyObject* loop = PyObject_CallMethod(asyncio, const_cast<char*>(getter), 0);
+    if (!loop || loop == Py_None) {
+        PyErr_Clear();
+        Py_XDECREF(loop);
+        return 0;
+    }
+    return loop;
+}
+
+PyObject* call(PyObject* callable, PyObject* args, PyObject* kwds)
+{
+    if (!startPool())
+        return 0;
+
+    PyObject* loop = runningLoop();
+    PyObject* future;
+    if (loop) {
+        future = PyObject_CallMethod(loop, const_cast<char*>("create_future"), 0);
+    } else {
+        AutoDecRef futures(PyImport_ImportModule("concurrent.futures"));
+        future = futures.isNull() ? 0 : PyObject_CallMethod(futures, const_cast<char*>("Future"), 0);
+    }
+    if (!future) {
+        Py_XDECREF(loop);
+        return 0;
+    }
+
+    if (args) {
+        Py_INCREF(args);
+    } else {
+        args = PyTuple_New(0);
+        if (!args) {
+            Py_DECREF(future);
+            Py_XDECREF(loop);
+            return 0;
+        }
+    }
+
+    Job* job = new Job;
+    Py_INCREF(callable);
+    job->callable = callable;
+    job->args = args;
+    job->kwds = kwds;
+    Py_XINCREF(kwds);
+    Py_INCREF(future);
+    job->future = future;
+    job->loop = loop;
+
+    PyThread_acquire_lock(jobsLock, WAIT_LOCK);
+    jobs.push_back(job);
+    if (!jobsSignaled) {
+        jobsSignaled = true;
+        PyThread_release_lock(jobsSignal);
+    }
+    PyThread_release_lock(jobsLock);
+    return future;
+}
+
+void setThreadCount(int count)
+{
+    if (count > 0)
+        threadCount = count;
+}
+
+} // namespace Async
+} // namespace Shiboken
@@ -0,0 +1,51 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef SBKASYNC_H
+#define SBKASYNC_H
+
+#include "sbkpython.h"
+#include "shibokenmacros.h"
+
+namespace Shiboken
+{
+namespace Async
+{
+
+/**
+ *  Calls \p callable with \p args and \p kwds on a thread of libshiboken's thread pool, and
+ *  returns a future for the result. Wrapped functions release the GIL around the C++ call,
+ *  so Python threads keep running while it takes place.
+ *  If an asyncio event loop is running in the calling thread the future belongs to it and is
+ *  resolved from the loop, otherwise a concurrent.futures.Future is returned.
+ *  Returns NULL, with a Python exception set, if neither is available.
+ */
+LIBSHIBOKEN_API PyObject* call(PyObject* callable, PyObject* args, PyObject* kwds);
+
+/// Sets the number of threads in the pool, 4 by default. It has no effect once the pool is running.
+LIBSHIBOKEN_API void setThreadCount(int count);
+
+} // namespace Async
+} // namespace Shiboken
+
+#endif // SBKASYNC_H
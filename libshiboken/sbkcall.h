@@ -0,0 +1,606 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef SBKCALL_H
+#define SBKCALL_H
+
+#include "sbkpython.h"
+#include "sbkconverter.h"
+#include "conversions.h"
+#include "autodecref.h"
+#include "gilstate.h"
+#include <cstddef>
+#include <typeinfo>
+
+namespace Shiboken
+{
+
+/**
+ *  Returns the converter registered for the C++ type \p T, i.e. the one of a primitive type
+ *  or of a wrapped class or enum, or 0 with a Python exception set if there's none.
+ */
+template<typename T>
+SbkConverter* typeConverter()
+{
+    if (SbkConverter* converter = Conversions::PrimitiveTypeConverter<T>())
+        return converter;
+    PyTypeObject* type = SbkType<T>();
+    if (type && (ObjectType::checkType(type) || Py_TYPE(type) == &SbkEnumType_Type))
+        return SBK_CONVERTER(type);
+    PyErr_Format(PyExc_TypeError, "There is no converter for the C++ type '%s'.", typeid(T).name());
+    return 0;
+}
+
+/**
+ *  Converts the arguments passed to call(). converter() looks up the converter used by toPython(),
+ *  which returns a new reference, or 0 with a Python exception set. Callers making many calls keep
+ *  the converter instead of looking it up every time.
+ */
+template<typename T>
+struct CallArgument
+{
+    static SbkConverter* converter() { return typeConverter<T>(); }
+    static PyObject* toPython(SbkConverter* converter, const T& cppIn)
+    {
+        return converter ? Conversions::copyToPython(converter, &cppIn) : 0;
+    }
+    static PyObject* toPython(const T& cppIn) { return toPython(converter(), cppIn); }
+};
+
+template<typename T>
+struct CallArgument<T*>
+{
+    static SbkConverter* converter() { return typeConverter<T>(); }
+    static PyObject* toPython(SbkConverter* converter, const T* cppIn)
+    {
+        return converter ? Conversions::pointerToPython(converter, cppIn) : 0;
+    }
+    static PyObject* toPython(const T* cppIn) { return toPython(converter(), cppIn); }
+};
+
+// The converters are registered for the unqualified types.
+template<typename T>
+struct CallArgument<const T*> : CallArgument<T*> {};
+
+template<>
+struct CallArgument<const char*>
+{
+    // The C string converter takes the pointer itself.
+    static SbkConverter* converter() { return Conversions::PrimitiveTypeConverter<const char*>(); }
+    static PyObject* toPython(SbkConverter* converter, const char* cppIn)
+    {
+        return Conversions::copyToPython(converter, cppIn);
+    }
+    static PyObject* toPython(const char* cppIn) { return toPython(converter(), cppIn); }
+};
+
+template<> struct CallArgument<char*> : CallArgument<const char*> {};
+template<std::size_t N> struct CallArgument<char[N]> : CallArgument<const char*> {};
+
+template<>
+struct CallArgument<PyObject*>
+{
+    static SbkConverter* converter() { return 0; }
+    static PyObject* toPython(SbkConverter*, PyObject* pyIn) { return toPython(pyIn); }
+    static PyObject* toPython(PyObject* pyIn)
+    {
+        Py_XINCREF(pyIn);
+        return pyIn;
+    }
+};
+
+/**
+ *  Converts the result of callAs(), with the converter looked up by converter(). On failure
+ *  returns a default constructed value and sets a Python exception.
+ */
+template<typename R>
+struct CallResult
+{
+    static SbkConverter* converter() { return typeConverter<R>(); }
+    static R toCpp(SbkConverter* converter, PyObject* pyIn)
+    {
+        R cppOut = R();
+        if (!pyIn || !converter)
+            return cppOut;
+        PythonToCppFunc toCpp = Conversions::isPythonToCppConvertible(converter, pyIn);
+        if (!toCpp) {
+            PyErr_Format(PyExc_TypeError, "Can't convert the '%s' object returned by the Python callable to '%s'.",
+                         Py_TYPE(pyIn)->tp_name, typeid(R).name());
+            return cppOut;
+        }
+        toCpp(pyIn, &cppOut);
+        return cppOut;
+    }
+    static R toCpp(PyObject* pyIn) { return pyIn ? toCpp(converter(), pyIn) : R(); }
+};
+
+template<typename T>
+struct CallResult<T*>
+{
+    static SbkConverter* converter() { return typeConverter<T>(); }
+    static T* toCpp(SbkConverter* converter, PyObject* pyIn)
+    {
+        T* cppOut = 0;
+        if (!pyIn || !converter)
+            return cppOut;
+        PyTypeObject* type = Conversions::getPythonTypeObject(converter);
+        PythonToCppFunc toCpp = 0;
+        if (type && ObjectType::checkType(type))
+            toCpp = Conversions::isPythonToCppPointerConvertible(reinterpret_cast<SbkObjectType*>(type), pyIn);
+        if (!toCpp) {
+            PyErr_Format(PyExc_TypeError, "Can't convert the '%s' object returned by the Python callable to '%s'.",
+                         Py_TYPE(pyIn)->tp_name, typeid(T*).name());
+            return cppOut;
+        }
+        toCpp(pyIn, &cppOut);
+        return cppOut;
+    }
+    static T* toCpp(PyObject* pyIn) { return pyIn ? toCpp(converter(), pyIn) : 0; }
+};
+
+template<typename T>
+struct CallResult<const T*> : CallResult<T*> {};
+
+template<>
+struct CallResult<void>
+{
+    static SbkConverter* converter() { return 0; }
+    static void toCpp(SbkConverter*, PyObject*) {}
+    static void toCpp(PyObject*) {}
+};
+
+template<>
+struct CallResult<PyObject*>
+{
+    static SbkConverter* converter() { return 0; }
+    static PyObject* toCpp(SbkConverter*, PyObject* pyIn) { return toCpp(pyIn); }
+    static PyObject* toCpp(PyObject* pyIn)
+    {
+        Py_XINCREF(pyIn);
+        return pyIn;
+    }
+};
+
+/**
+ *  Calls \p callable with the \p size arguments in \p args, stealing their references.
+ *  A null argument means its conversion failed, then the call isn't made and 0 is returned.
+ */
+inline PyObject* callWithArguments(PyObject* callable, PyObject** args, int size)
+{
+    PyObject* tuple = PyTuple_New(size);
+    bool failed = !tuple;
+    for (int i = 0; i < size; ++i) {
+        failed = failed || !args[i];
+        if (tuple)
+            PyTuple_SET_ITEM(tuple, i, args[i]);
+        else
+            Py_XDECREF(args[i]);
+    }
+    PyObject* result = failed ? 0 : PyObject_Call(callable, tuple, 0);
+    Py_XDECREF(tuple);
+    return result;
+}
+
+/**
+ *  Calls the Python \p callable with up to 6 arguments, converted from C++ with the converters
+ *  registered for their types, and returns a new reference to the result. The arguments
+ *  may be values of primitive types, wrapped classes and enums, pointers to wrapped objects,
+ *  C strings or PyObject pointers.
+ *  Returns 0 with a Python exception set if a conversion or the call fails.
+ *  Must be called with the GIL held.
+ */
+inline PyObject* call(PyObject* callable)
+{
+    return callWithArguments(callable, 0, 0);
+}
+
+template<typename A1>
+PyObject* call(PyObject* callable, const A1& a1)
+{
+    PyObject* args[] = { CallArgument<A1>::toPython(a1) };
+    return callWithArguments(callable, args, 1);
+}
+
+template<typename A1, typename A2>
+PyObject* call(PyObject* callable, const A1& a1, const A2& a2)
+{
+    PyObject* args[] = { CallArgument<A1>::toPython(a1), CallArgument<A2>::toPython(a2) };
+    return callWithArguments(callable, args, 2);
+}
+
+template<typename A1, typename A2, typename A3>
+PyObject* call(PyObject* callable, const A1& a1, const A2& a2, const A3& a3)
+{
+    PyObject* args[] = { CallArgument<A1>::toPython(a1), CallArgument<A2>::toPython(a2), CallArgument<A3>::toPython(a3) };
+    return callWithArguments(callable, args, 3);
+}
+
+template<typename A1, typename A2, typename A3, typename A4>
+PyObject* call(PyObject* callable, const A1& a1, const A2& a2, const A3& a3, const A4& a4)
+{
+    PyObject* args[] = { CallArgument<A1>::toPython(a1), CallArgument<A2>::toPython(a2), CallArgument<A3>::toPython(a3), CallArgument<A4>::toPython(a4) };
+    return callWithArguments(callable, args, 4);
+}
+
+template<typename A1, typename A2, typename A3, typename A4, typename A5>
+PyObject* call(PyObject* callable, const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5)
+{
+    PyObject* args[] = { CallArgument<A1>::toPython(a1), CallArgument<A2>::toPython(a2), CallArgument<A3>::toPython(a3), CallArgument<A4>::toPython(a4), CallArgument<A5>::toPython(a5) };
+    return callWithArguments(callable, args, 5);
+}
+
+template<typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+PyObject* call(PyObject* callable, const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5, const A6& a6)
+{
+    PyObject* args[] = { CallArgument<A1>::toPython(a1), CallArgument<A2>::toPython(a2), CallArgument<A3>::toPython(a3), CallArgument<A4>::toPython(a4), CallArgument<A5>::toPython(a5), CallArgument<A6>::toPython(a6) };
+    return callWithArguments(callable, args, 6);
+}
+
+/**
+ *  Calls the Python \p callable like call() does and converts the result to the C++ type \p R,
+ *  which may also be void, PyObject* (returned as a new reference) or a pointer to a wrapped class.
+ *  If a conversion or the call fails, a Python exception is set and a default constructed
+ *  \p R is returned, so callers must check PyErr_Occurred().
+ *  Must be called with the GIL held.
+ */
+template<typename R>
+R callAs(PyObject* callable)
+{
+    AutoDecRef result(call(callable));
+    return CallResult<R>::toCpp(result);
+}
+
+template<typename R, typename A1>
+R callAs(PyObject* callable, const A1& a1)
+{
+    AutoDecRef result(call(callable, a1));
+    return CallResult<R>::toCpp(result);
+}
+
+template<typename R, typename A1, typename A2>
+R callAs(PyObject* callable, const A1& a1, const A2& a2)
+{
+    AutoDecRef result(call(callable, a1, a2));
+    return CallResult<R>::toCpp(result);
+}
+
+template<typename R, typename A1, typename A2, typename A3>
+R callAs(PyObject* callable, const A1& a1, const A2& a2, const A3& a3)
+{
+    AutoDecRef result(call(callable, a1, a2, a3));
+    return CallResult<R>::toCpp(result);
+}
+
+template<typename R, typename A1, typename A2, typename A3, typename A4>
+R callAs(PyObject* callable, const A1& a1, const A2& a2, const A3& a3, const A4& a4)
+{
+    AutoDecRef result(call(callable, a1, a2, a3, a4));
+    return CallResult<R>::toCpp(result);
+}
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5>
+R callAs(PyObject* callable, const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5)
+{
+    AutoDecRef result(call(callable, a1, a2, a3, a4, a5));
+    return CallResult<R>::toCpp(result);
+}
+
+template<typename R, typename A1, typename A2, typename A3, typename A4, typename A5, typename A6>
+R callAs(PyObject* callable, const A1& a1, const A2& a2, const A3& a3, const A4& a4, const A5& a5, const A6& a6)
+{
+    AutoDecRef result(call(callable, a1, a2, a3, a4, a5, a6));
+    return CallResult<R>::toCpp(result);
+}
+
+/// Gives the type converted by CallArgument for a parameter of a function type, e.g. Point for const Point&.
+template<typename T>
+struct CallArgumentType
+{
+    typedef T Type;
+};
+
+template<typename T>
+struct CallArgumentType<const T>
+{
+    typedef T Type;
+};
+
+template<typename T>
+struct CallArgumentType<T&>
+{
+    typedef typename CallArgumentType<T>::Type Type;
+};
+
+/**
+ *  Holds a reference to a Python callable, taking the GIL to copy or release it, and the converters
+ *  of the PythonFunction signature, looked up by the first call.
+ */
+class PythonFunctionBase
+{
+public:
+    explicit PythonFunctionBase(PyObject* callable) : m_callable(callable), m_hasConverters(false)
+    {
+        Py_XINCREF(m_callable);
+    }
+    PythonFunctionBase(const PythonFunctionBase& other) : m_callable(other.m_callable), m_hasConverters(false)
+    {
+        GilState gil;
+        Py_XINCREF(m_callable);
+    }
+    ~PythonFunctionBase()
+    {
+        GilState gil;
+        Py_XDECREF(m_callable);
+    }
+    PythonFunctionBase& operator=(const PythonFunctionBase& other)
+    {
+        GilState gil;
+        Py_XINCREF(other.m_callable);
+        Py_XDECREF(m_callable);
+        m_callable = other.m_callable;
+        return *this;
+    }
+    PyObject* callable() const { return m_callable; }
+
+protected:
+    PyObject* m_callable;
+    // The converter of the result followed by those of the arguments. Only used with the GIL held.
+    mutable SbkConverter* m_converters[5];
+    mutable bool m_hasConverters;
+};
+
+/**
+ *  Wraps a Python callable in a C++ functor with the function type \p Signature, taking up to 4
+ *  arguments, e.g. PythonFunction<bool(int, int)> can be passed as comparator to std::sort.
+ *  The argument and result converters are looked up by the first call and kept by the functor,
+ *  every call still builds an argument tuple and calls the callable through Python.
+ *  Calls can be made by any thread, the GIL is acquired when needed.
+ *
+ *  For C style callbacks taking a function pointer and user data, pass PythonFunction::invoke as the
+ *  function and the address of the PythonFunction as the user data, which must be the last argument.
+ *
+ *  Python errors are not propagated through the C++ code calling the functor: an error stays set,
+ *  further calls return a default constructed value without calling Python, and the error is raised
+ *  when the C++ function called from Python returns.
+ */
+template<typename Signature>
+class PythonFunction;
+
+template<typename R>
+class PythonFunction<R()> : public PythonFunctionBase
+{
+public:
+    explicit PythonFunction(PyObject* callable) : PythonFunctionBase(callable) {}
+    R operator()() const
+    {
+        GilState gil;
+        if (PyErr_Occurred() || !hasConverters())
+            return R();
+        AutoDecRef result(callWithArguments(m_callable, 0, 0));
+        return CallResult<R>::toCpp(m_converters[0], result);
+    }
+    static R invoke(void* userData) { return (*reinterpret_cast<const PythonFunction*>(userData))(); }
+
+private:
+    bool hasConverters() const
+    {
+        if (!m_hasConverters) {
+            m_converters[0] = CallResult<R>::converter();
+            m_hasConverters = !PyErr_Occurred();
+        }
+        return m_hasConverters;
+    }
+};
+
+template<typename R, typename A1>
+class PythonFunction<R(A1)> : public PythonFunctionBase
+{
+public:
+    explicit PythonFunction(PyObject* callable) : PythonFunctionBase(callable) {}
+    R operator()(A1 a1) const
+    {
+        GilState gil;
+        if (PyErr_Occurred() || !hasConverters())
+            return R();
+        PyObject* args[] = {
+            CallArgument<typename CallArgumentType<A1>::Type>::toPython(m_converters[1], a1)
+        };
+        AutoDecRef result(callWithArguments(m_callable, args, 1));
+        return CallResult<R>::toCpp(m_converters[0], result);
+    }
+    static R invoke(A1 a1, void* userData) { return (*reinterpret_cast<const PythonFunction*>(userData))(a1); }
+
+private:
+    bool hasConverters() const
+    {
+        if (!m_hasConverters) {
+            m_converters[0] = CallResult<R>::converter();
+            m_converters[1] = CallArgument<typename CallArgumentType<A1>::Type>::converter();
+            m_hasConverters = !PyErr_Occurred();
+        }
+        return m_hasConverters;
+    }
+};
+
+template<typename R, typename A1, typename A2>
+class PythonFunction<R(A1, A2)> : public PythonFunctionBase
+{
+public:
+    explicit PythonFunction(PyObject* callable) : PythonFunctionBase(callable) {}
+    R operator()(A1 a1, A2 a2) const
+    {
+        GilState gil;
+        if (PyErr_Occurred() || !hasConverters())
+            return R();
+        PyObject* args[] = {
+            CallArgument<typename CallArgumentType<A1>::Type>::toPython(m_converters[1], a1),
+            CallArgument<typename CallArgumentType<A2>::Type>::toPython(m_converters[2], a2)
+        };
+        AutoDecRef result(callWithArguments(m_callable, args, 2));
+        return CallResult<R>::toCpp(m_converters[0], result);
+    }
+    static R invoke(A1 a1, A2 a2, void* userData) { return (*reinterpret_cast<const PythonFunction*>(userData))(a1, a2); }
+
+private:
+    bool hasConverters() const
+    {
+        if (!m_hasConverters) {
+            m_converters[0] = CallResult<R>::converter();
+            m_converters[1] = CallArgument<typename CallArgumentType<A1>::Type>::converter();
+            m_converters[2] = CallArgument<typename CallArgumentType<A2>::Type>::converter();
+            m_hasConverters = !PyErr_Occurred();
+        }
+        return m_hasConverters;
+    }
+};
+
+template<typename R, typename A1, typename A2, typename A3>
+class PythonFunction<R(A1, A2, A3)> : public PythonFunctionBase
+{
+public:
+    explicit PythonFunction(PyObject* callable) : PythonFunctionBase(callable) {}
+    R operator()(A1 a1, A2 a2, A3 a3) const
+    {
+        GilState gil;
+        if (PyErr_Occurred() || !hasConverters())
+            return R();
+        PyObject* args[] = {
+            CallArgument<typename CallArgumentType<A1>::Type>::toPython(m_converters[1], a1),
+            CallArgument<typename CallArgumentType<A2>::Type>::toPython(m_converters[2], a2),
+            CallArgument<typename CallArgumentType<A3>::Type>::toPython(m_converters[3], a3)
+        };
+        AutoDecRef result(callWithArguments(m_callable, args, 3));
+        return CallResult<R>::toCpp(m_converters[0], result);
+    }
+    static R invoke(A1 a1, A2 a2, A3 a3, void* userData) { return (*reinterpret_cast<const PythonFunction*>(userData))(a1, a2, a3); }
+
+private:
+    bool hasConverters() const
+    {
+        if (!m_hasConverters) {
+            m_converters[0] = CallResult<R>::converter();
+            m_converters[1] = CallArgument<typename CallArgumentType<A1>::Type>::converter();
+            m_converters[2] = CallArgument<typename CallArgumentType<A2>::Type>::converter();
+            m_converters[3] = CallArgument<typename CallArgumentType<A3>::Type>::converter();
+            m_hasConverters = !PyErr_Occurred();
+        }
+        return m_hasConverters;
+    }
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4>
+class PythonFunction<R(A1, A2, A3, A4)> : public PythonFunctionBase
+{
+public:
+    explicit PythonFunction(PyObject* callable) : PythonFunctionBase(callable) {}
+    R operator()(A1 a1, A2 a2, A3 a3, A4 a4) const
+    {
+        GilState gil;
+        if (PyErr_Occurred() || !hasConverters())
+            return R();
+        PyObject* args[] = {
+            CallArgument<typename CallArgumentType<A1>::Type>::toPython(m_converters[1], a1),
+            CallArgument<typename CallArgumentType<A2>::Type>::toPython(m_converters[2], a2),
+            CallArgument<typename CallArgumentType<A3>::Type>::toPython(m_converters[3], a3),
+            CallArgument<typename CallArgumentType<A4>::Type>::toPython(m_converters[4], a4)
+        };
+        AutoDecRef result(callWithArguments(m_callable, args, 4));
+        return CallResult<R>::toCpp(m_converters[0], result);
+    }
+    static R invoke(A1 a1, A2 a2, A3 a3, A4 a4, void* userData) { return (*reinterpret_cast<const PythonFunction*>(userData))(a1, a2, a3, a4); }
+
+private:
+    bool hasConverters() const
+    {
+        if (!m_hasConverters) {
+            m_converters[0] = CallResult<R>::converter();
+            m_converters[1] = CallArgument<typename CallArgumentType<A1>::Type>::converter();
+            m_converters[2] = CallArgument<typename CallArgumentType<A2>::Type>::converter();
+            m_converters[3] = CallArgument<typename CallArgumentType<A3>::Type>::converter();
+            m_converters[4] = CallArgument<typename CallArgumentType<A4>::Type>::converter();
+            m_hasConverters = !PyErr_Occurred();
+        }
+        return m_hasConverters;
+    }
+};
+
+/**
+ *  A PythonFunction passed to C style functions as a callback of the function pointer type
+ *  \p FunctionPointer, whose last argument is the user data, e.g. bool (*)(int, void*).
+ *  function() and userData() give the arguments to pass, both valid while the PythonCallback lives.
+ *  The generator uses it for the "callback-types" option.
+ */
+template<typename Signature, typename FunctionPointer>
+class PythonCallbackBase : public PythonFunction<Signature>
+{
+public:
+    explicit PythonCallbackBase(PyObject* callable) : PythonFunction<Signature>(callable) {}
+    FunctionPointer function() const { return &PythonFunction<Signature>::invoke; }
+    void* userData() const
+    {
+        // invoke() takes the user data as a pointer to the PythonFunction.
+        return const_cast<PythonFunction<Signature>*>(static_cast<const PythonFunction<Signature>*>(this));
+    }
+};
+
+template<typename FunctionPointer>
+class PythonCallback;
+
+template<typename R>
+class PythonCallback<R (*)(void*)> : public PythonCallbackBase<R(), R (*)(void*)>
+{
+public:
+    explicit PythonCallback(PyObject* callable) : PythonCallbackBase<R(), R (*)(void*)>(callable) {}
+};
+
+template<typename R, typename A1>
+class PythonCallback<R (*)(A1, void*)> : public PythonCallbackBase<R(A1), R (*)(A1, void*)>
+{
+public:
+    explicit PythonCallback(PyObject* callable) : PythonCallbackBase<R(A1), R (*)(A1, void*)>(callable) {}
+};
+
+template<typename R, typename A1, typename A2>
+class PythonCallback<R (*)(A1, A2, void*)> : public PythonCallbackBase<R(A1, A2), R (*)(A1, A2, void*)>
+{
+public:
+    explicit PythonCallback(PyObject* callable) : PythonCallbackBase<R(A1, A2), R (*)(A1, A2, void*)>(callable) {}
+};
+
+template<typename R, typename A1, typename A2, typename A3>
+class PythonCallback<R (*)(A1, A2, A3, void*)> : public PythonCallbackBase<R(A1, A2, A3), R (*)(A1, A2, A3, void*)>
+{
+public:
+    explicit PythonCallback(PyObject* callable) : PythonCallbackBase<R(A1, A2, A3), R (*)(A1, A2, A3, void*)>(callable) {}
+};
+
+template<typename R, typename A1, typename A2, typename A3, typename A4>
+class PythonCallback<R (*)(A1, A2, A3, A4, void*)> : public PythonCallbackBase<R(A1, A2, A3, A4), R (*)(A1, A2, A3, A4, void*)>
+{
+public:
+    explicit PythonCallback(PyObject* callable) : PythonCallbackBase<R(A1, A2, A3, A4), R (*)(A1, A2, A3, A4, void*)>(callable) {}
+};
+
+} // namespace Shiboken
+
+#endif // SBKCALL_H
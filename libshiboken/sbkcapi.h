@@ -0,0 +1,124 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef SBKCAPI_H
+#define SBKCAPI_H
+
+/*
+ * C interface exported by every generated module as its "_C_API" attribute.
+ * This header doesn't depend on any other Shiboken header and can be used
+ * from C extensions or Cython, to reach the C++ objects held by the wrappers
+ * and to wrap C++ objects without going through Python calls.
+ *
+ * The types array is indexed by the SBK_<TYPE>_IDX values, and the converters
+ * array by the SBK_<TYPE>_IDX values of the containers and primitive types,
+ * both defined in the module header, e.g. "sample_python.h".
+ */
+
+#include <Python.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+struct SbkConverter;
+
+#define SBK_C_API_VERSION 1
+
+/* Py_LOCAL_INLINE is plain "static" with Python 2 on most compilers, which then warn about
+   SbkCApi_Import being unused in every file that includes this header without calling it. */
+#if defined(__cplusplus)
+#  define SBK_CAPI_INLINE(type) static inline type
+#elif defined(__GNUC__)
+#  define SBK_CAPI_INLINE(type) static __inline__ type
+#else
+#  define SBK_CAPI_INLINE(type) Py_LOCAL_INLINE(type)
+#endif
+
+typedef struct SbkCApi
+{
+    /* Equal to SBK_C_API_VERSION when the module was generated. */
+    int version;
+
+    PyTypeObject** types;
+    int typeCount;
+    struct SbkConverter** converters;
+    int converterCount;
+
+    /* Returns the C++ pointer held by pyIn for the given type, or NULL with a Python exception set
+       if pyIn isn't an instance of it or its C++ object was deleted. */
+    void* (*cppPointer)(PyObject* pyIn, PyTypeObject* type);
+    /* Returns a new reference to a wrapper for cppIn, reusing an existing wrapper if any. */
+    PyObject* (*pointerToPython)(PyTypeObject* type, const void* cppIn);
+    /* As above, for C++ objects owned by someone else. */
+    PyObject* (*referenceToPython)(PyTypeObject* type, const void* cppIn);
+    /* Returns a new reference to a wrapper holding a copy of the value type object cppIn. */
+    PyObject* (*copyToPython)(PyTypeObject* type, const void* cppIn);
+    /* Copies pyIn, or what it's implicitly convertible to, into the value type object cppOut. Returns 0 on failure. */
+    int (*pythonToCppCopy)(PyTypeObject* type, PyObject* pyIn, void* cppOut);
+    /* Returns a new reference to the Python object converted from the non-wrapper type value cppIn. */
+    PyObject* (*converterToPython)(struct SbkConverter* converter, const void* cppIn);
+    /* Converts pyIn into the non-wrapper type value cppOut. Returns 0 on failure. */
+    int (*converterToCpp)(struct SbkConverter* converter, PyObject* pyIn, void* cppOut);
+} SbkCApi;
+
+/*
+ * Imports moduleName, e.g. "sample", and returns its C interface, or NULL with
+ * a Python exception set if it's not available.
+ */
+SBK_CAPI_INLINE(SbkCApi*) SbkCApi_Import(const char* moduleName)
+{
+    SbkCApi* api = 0;
+    PyObject* capsule;
+    PyObject* module = PyImport_ImportModule(moduleName);
+    if (!module)
+        return 0;
+    capsule = PyObject_GetAttrString(module, "_C_API");
+    Py_DECREF(module);
+    if (!capsule)
+        return 0;
+#if PY_MAJOR_VERSION >= 3
+    if (PyCapsule_CheckExact(capsule))
+        api = (SbkCApi*)PyCapsule_GetPointer(capsule, PyCapsule_GetName(capsule));
+#else
+    /* Python 2.6 doesn't have PyCapsule API, so PyCObject is used on all Python 2.x */
+    if (PyCObject_Check(capsule))
+        api = (SbkCApi*)PyCObject_AsVoidPtr(capsule);
+#endif
+    Py_DECREF(capsule);
+    if (api && api->version != SBK_C_API_VERSION) {
+        PyErr_Format(PyExc_ImportError, "module '%s' exports C API version %d, expected %d",
+                     moduleName, api->version, SBK_C_API_VERSION);
+        return 0;
+    }
+    if (!api && !PyErr_Occurred())
+        PyErr_Format(PyExc_ImportError, "module '%s' doesn't export a C API", moduleName);
+    return api;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SBKCAPI_H */
@@ -0,0 +1,301 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "sbkcontainerview.h"
+#include "basewrapper.h"
+#include "autodecref.h"
+
+using namespace Shiboken;
+
+extern "C"
+{
+
+struct SbkContainerView
+{
+    PyObject_HEAD
+    PyObject* owner;
+    const void* container;
+    const ContainerView::ViewOperations* ops;
+    SbkConverter* converters[2];
+};
+
+static void SbkContainerViewDealloc(PyObject* pyObj)
+{
+    Py_XDECREF(reinterpret_cast<SbkContainerView*>(pyObj)->owner);
+    PyObject_Del(pyObj);
+}
+
+// The container belongs to the owner's C++ object, it must not be touched after its deletion.
+static inline bool SbkContainerViewIsValid(SbkContainerView* self)
+{
+    return Object::isValid(self->owner, true);
+}
+
+static Py_ssize_t SbkContainerViewLength(PyObject* pyObj)
+{
+    SbkContainerView* self = reinterpret_cast<SbkContainerView*>(pyObj);
+    if (!SbkContainerViewIsValid(self))
+        return -1;
+    return self->ops->size(self->container);
+}
+
+static PyObject* SbkContainerViewCopy(PyObject* pyObj)
+{
+    SbkContainerView* self = reinterpret_cast<SbkContainerView*>(pyObj);
+    if (!SbkContainerViewIsValid(self))
+        return 0;
+    return self->ops->copy(self->container, self->converters);
+}
+
+static PyObject* SbkSequenceViewItem(PyObject* pyObj, Py_ssize_t index)
+{
+    SbkContainerView* self = reinterpret_cast<SbkContainerView*>(pyObj);
+    if (!SbkContainerViewIsValid(self))
+        return 0;
+    if (index < 0 || index >= self->ops->size(self->container)) {
+        PyErr_SetString(PyExc_IndexError, "index out of bounds");
+        return 0;
+    }
+    return self->ops->item(self->container, index, self->converters);
+}
+
+// Walks the C++ container with its own iterators, instead of an indexed access
+// (linear on std::list) for each item.
+static PyObject* SbkContainerViewIter(PyObject* pyObj)
+{
+    SbkContainerView* self = reinterpret_cast<SbkContainerView*>(pyObj);
+    if (!SbkContainerViewIsValid(self))
+        return 0;
+    return self->ops->iterate(self->owner, self->container, self->converters);
+}
+
+static PyObject* SbkMappingViewSubscript(PyObject* pyObj, PyObject* key)
+{
+    SbkContainerView* self = reinterpret_cast<SbkContainerView*>(pyObj);
+    if (!SbkContainerViewIsValid(self))
+        return 0;
+    return self->ops->lookup(self->container, key, self->converters);
+}
+
+static int SbkMappingViewContains(PyObject* pyObj, PyObject* key)
+{
+    AutoDecRef value(SbkMappingViewSubscript(pyObj, key));
+    if (!value.isNull())
+        return 1;
+    if (!PyErr_ExceptionMatches(PyExc_KeyError))
+        return -1;
+    PyErr_Clear();
+    return 0;
+}
+
+static PyObject* SbkMappingViewKeys(PyObject* pyObj)
+{
+    SbkContainerView* self = reinterpret_cast<SbkContainerView*>(pyObj);
+    if (!SbkContainerViewIsValid(self))
+        return 0;
+    return self->ops->keys(self->container, self->converters);
+}
+
+static PyObject* SbkMappingViewGet(PyObject* pyObj, PyObject* args)
+{
+    PyObject* key;
+    PyObject* defaultValue = Py_None;
+    if (!PyArg_UnpackTuple(args, "get", 1, 2, &key, &defaultValue))
+        return 0;
+    PyObject* value = SbkMappingViewSubscript(pyObj, key);
+    if (value || !PyErr_ExceptionMatches(PyExc_KeyError))
+        return value;
+    PyErr_Clear();
+    Py_INCREF(defaultValue);
+    return defaultValue;
+}
+
+static PySequenceMethods SbkSequenceViewAsSequence = {
+    /*sq_length*/           SbkContainerViewLength,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             SbkSequenceViewItem,
+    /*sq_slice*/            0,
+    /*sq_ass_item*/         0,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         0,
+    /*sq_inplace_concat*/   0,
+    /*sq_inplace_repeat*/   0
+};
+
+static PySequenceMethods SbkMappingViewAsSequence = {
+    /*sq_length*/           0,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             0,
+    /*sq_slice*/            0,
+    /*sq_ass_item*/         0,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         SbkMappingViewContains,
+    /*sq_inplace_concat*/   0,
+    /*sq_inplace_repeat*/   0
+};
+
+static PyMappingMethods SbkMappingViewAsMapping = {
+    /*mp_length*/           SbkContainerViewLength,
+    /*mp_subscript*/        SbkMappingViewSubscript,
+    /*mp_ass_subscript*/    0
+};
+
+static PyMethodDef SbkSequenceViewMethods[] = {
+    {"copy", (PyCFunction)SbkContainerViewCopy, METH_NOARGS, "Returns a list with copies of all the items."},
+    {0, 0, 0, 0}
+};
+
+static PyMethodDef SbkMappingViewMethods[] = {
+    {"copy", (PyCFunction)SbkContainerViewCopy, METH_NOARGS, "Returns a dict with copies of all the items."},
+    {"keys", (PyCFunction)SbkMappingViewKeys, METH_NOARGS, "Returns a list with copies of all the keys."},
+    {"get", (PyCFunction)SbkMappingViewGet, METH_VARARGS, "Returns the value for a key, or a default value."},
+    {0, 0, 0, 0}
+};
+
+PyTypeObject SbkSequenceView_Type = {
+    PyVarObject_HEAD_INIT(0, 0)
+    /*tp_name*/             "Shiboken.SequenceView",
+    /*tp_basicsize*/        sizeof(SbkContainerView),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkContainerViewDealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             0,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkSequenceViewAsSequence,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Read only view over a C++ sequence container.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      0,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             SbkContainerViewIter,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          SbkSequenceViewMethods,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+PyTypeObject SbkMappingView_Type = {
+    PyVarObject_HEAD_INIT(0, 0)
+    /*tp_name*/             "Shiboken.MappingView",
+    /*tp_basicsize*/        sizeof(SbkContainerView),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkContainerViewDealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             0,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkMappingViewAsSequence,
+    /*tp_as_mapping*/       &SbkMappingViewAsMapping,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Read only view over a C++ associative container.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      0,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             SbkContainerViewIter,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          SbkMappingViewMethods,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
+namespace Shiboken
+{
+
+namespace ContainerView
+{
+
+PyObject* newView(PyTypeObject* type, PyObject* owner, const void* container,
+                  const ViewOperations* operations,
+                  SbkConverter* firstConverter, SbkConverter* secondConverter)
+{
+    if (!PyType_HasFeature(type, Py_TPFLAGS_READY) && PyType_Ready(type) < 0)
+        return 0;
+    SbkContainerView* self = PyObject_New(SbkContainerView, type);
+    if (!self)
+        return 0;
+    self->owner = owner;
+    Py_XINCREF(owner);
+    self->container = container;
+    self->ops = operations;
+    self->converters[0] = firstConverter;
+    self->converters[1] = secondConverter;
+    return reinterpret_cast<PyObject*>(self);
+}
+
+} // namespace ContainerView
+
+} // namespace Shiboken
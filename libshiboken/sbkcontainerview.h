@@ -0,0 +1,348 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef SBKCONTAINERVIEW_H
+#define SBKCONTAINERVIEW_H
+
+#include "sbkpython.h"
+#include "shibokenmacros.h"
+#include "sbkconverter.h"
+#include "sbkiterator.h"
+#include <iterator>
+
+extern "C"
+{
+
+/// Python type of the read only views over C++ sequence containers.
+extern LIBSHIBOKEN_API PyTypeObject SbkSequenceView_Type;
+/// Python type of the read only views over C++ associative containers.
+extern LIBSHIBOKEN_API PyTypeObject SbkMappingView_Type;
+
+} // extern "C"
+
+namespace Shiboken
+{
+
+namespace ContainerView
+{
+
+/**
+ * Table of functions a view uses to access the C++ container it was made for.
+ * The \p converters argument are the converters given when the view was created:
+ * the item converter for sequences, and the key and value converters for mappings.
+ */
+struct ViewOperations
+{
+    Py_ssize_t (*size)(const void* container);
+    /// Sequences only: returns a new reference to the Python version of the item at \p index.
+    PyObject* (*item)(const void* container, Py_ssize_t index, SbkConverter* const* converters);
+    /// Mappings only: returns a new reference to the value for \p key, or NULL with a KeyError set.
+    PyObject* (*lookup)(const void* container, PyObject* key, SbkConverter* const* converters);
+    /// Mappings only: returns a new Python list with the keys of the container.
+    PyObject* (*keys)(const void* container, SbkConverter* const* converters);
+    /// Returns a new Python list (or dict, for mappings) with all the items of the container.
+    PyObject* (*copy)(const void* container, SbkConverter* const* converters);
+    /**
+     * Returns a Shiboken.Iterator over the items (or keys, for mappings) of the container,
+     * converting them one at a time. The iterator keeps a reference to \p owner.
+     */
+    PyObject* (*iterate)(PyObject* owner, const void* container, SbkConverter* const* converters);
+};
+
+/**
+ * Creates a view of \p type (SbkSequenceView_Type or SbkMappingView_Type) over \p container,
+ * using \p operations to access it. A reference to \p owner is kept while the view is alive,
+ * and if \p owner is a Shiboken wrapper the view refuses to access the container after the
+ * wrapper's C++ object is deleted.
+ * Use newSequence and newMapping instead of calling this directly.
+ */
+LIBSHIBOKEN_API PyObject* newView(PyTypeObject* type, PyObject* owner, const void* container,
+                                  const ViewOperations* operations,
+                                  SbkConverter* firstConverter, SbkConverter* secondConverter);
+
+/// Converts container items, or keys, to Python.
+template<typename T>
+struct ItemConverter
+{
+    static PyObject* toPython(SbkConverter* converter, const T& cppItem)
+    {
+        return Conversions::copyToPython(converter, &cppItem);
+    }
+    static bool toCpp(SbkConverter* converter, PyObject* pyIn, T* cppOut)
+    {
+        PythonToCppFunc toCppFunc = Conversions::isPythonToCppConvertible(converter, pyIn);
+        if (!toCppFunc)
+            return false;
+        toCppFunc(pyIn, cppOut);
+        return !PyErr_Occurred();
+    }
+};
+
+template<typename T>
+struct ItemConverter<T*>
+{
+    static PyObject* toPython(SbkConverter* converter, T* const& cppItem)
+    {
+        return Conversions::pointerToPython(converter, cppItem);
+    }
+    static bool toCpp(SbkConverter* converter, PyObject* pyIn, T** cppOut)
+    {
+        SbkObjectType* type = reinterpret_cast<SbkObjectType*>(Conversions::getPythonTypeObject(converter));
+        PythonToCppFunc toCppFunc = Conversions::isPythonToCppPointerConvertible(type, pyIn);
+        if (!toCppFunc)
+            return false;
+        toCppFunc(pyIn, cppOut);
+        return !PyErr_Occurred();
+    }
+};
+
+/**
+ * Position of a Shiboken.Iterator created by a view, with the size the container had when it started.
+ * No C++ iterator is kept between the steps, since the container may be changed in the meantime.
+ */
+template<typename Container>
+struct IterationState
+{
+    const Container* container;
+    typename Container::size_type size;
+    typename Container::size_type position;
+    SbkConverter* converter;
+
+    static IterationState* create(const void* container, SbkConverter* converter)
+    {
+        IterationState* state = new IterationState;
+        state->container = static_cast<const Container*>(container);
+        state->size = state->container->size();
+        state->position = 0;
+        state->converter = converter;
+        return state;
+    }
+
+    /**
+     * Returns false when the iteration is over, with a RuntimeError set if the container was resized
+     * since the iteration started. Otherwise sets \p item to the current position and advances it.
+     */
+    bool next(typename Container::const_iterator* item)
+    {
+        typename Container::size_type containerSize = container->size();
+        if (containerSize != size) {
+            PyErr_SetString(PyExc_RuntimeError, "container changed size during iteration");
+            return false;
+        }
+        if (position >= containerSize)
+            return false;
+        // Constant time for random access containers, linear for the others.
+        *item = container->begin();
+        std::advance(*item, position++);
+        return true;
+    }
+
+    static void destroy(void* state)
+    {
+        delete static_cast<IterationState*>(state);
+    }
+};
+
+/// View operations for sequence containers: std::list, std::vector, std::deque and the like.
+template<typename Container>
+struct SequenceOperations
+{
+    typedef ItemConverter<typename Container::value_type> Converter;
+
+    static Py_ssize_t size(const void* container)
+    {
+        return static_cast<const Container*>(container)->size();
+    }
+
+    static PyObject* item(const void* container, Py_ssize_t index, SbkConverter* const* converters)
+    {
+        const Container* cppContainer = static_cast<const Container*>(container);
+        Py_ssize_t containerSize = cppContainer->size();
+        // Walks from the nearest end on containers without random access.
+        typename Container::const_iterator it;
+        if (index < containerSize / 2) {
+            it = cppContainer->begin();
+            std::advance(it, index);
+        } else {
+            it = cppContainer->end();
+            std::advance(it, index - containerSize);
+        }
+        return Converter::toPython(converters[0], *it);
+    }
+
+    static PyObject* copy(const void* container, SbkConverter* const* converters)
+    {
+        const Container* cppContainer = static_cast<const Container*>(container);
+        PyObject* result = PyList_New(cppContainer->size());
+        if (!result)
+            return 0;
+        Py_ssize_t idx = 0;
+        for (typename Container::const_iterator it = cppContainer->begin(); it != cppContainer->end(); ++it, ++idx) {
+            PyObject* pyItem = Converter::toPython(converters[0], *it);
+            if (!pyItem) {
+                Py_DECREF(result);
+                return 0;
+            }
+            PyList_SET_ITEM(result, idx, pyItem);
+        }
+        return result;
+    }
+
+    static PyObject* next(void* state)
+    {
+        IterationState<Container>* it = static_cast<IterationState<Container>*>(state);
+        typename Container::const_iterator item;
+        if (!it->next(&item))
+            return 0;
+        return Converter::toPython(it->converter, *item);
+    }
+
+    static PyObject* iterate(PyObject* owner, const void* container, SbkConverter* const* converters)
+    {
+        return Iterator::create(owner, IterationState<Container>::create(container, converters[0]),
+                                &next, &IterationState<Container>::destroy);
+    }
+
+    static const ViewOperations* operations()
+    {
+        static const ViewOperations ops = { &size, &item, 0, 0, &copy, &iterate };
+        return &ops;
+    }
+};
+
+/// View operations for associative containers: std::map and the like.
+template<typename Container>
+struct MappingOperations
+{
+    typedef ItemConverter<typename Container::key_type> KeyConverter;
+    typedef ItemConverter<typename Container::mapped_type> ValueConverter;
+
+    static Py_ssize_t size(const void* container)
+    {
+        return static_cast<const Container*>(container)->size();
+    }
+
+    static PyObject* lookup(const void* container, PyObject* key, SbkConverter* const* converters)
+    {
+        const Container* cppContainer = static_cast<const Container*>(container);
+        typename Container::key_type cppKey;
+        if (KeyConverter::toCpp(converters[0], key, &cppKey)) {
+            typename Container::const_iterator it = cppContainer->find(cppKey);
+            if (it != cppContainer->end())
+                return ValueConverter::toPython(converters[1], it->second);
+        }
+        if (!PyErr_Occurred())
+            PyErr_SetObject(PyExc_KeyError, key);
+        return 0;
+    }
+
+    static PyObject* keys(const void* container, SbkConverter* const* converters)
+    {
+        const Container* cppContainer = static_cast<const Container*>(container);
+        PyObject* result = PyList_New(cppContainer->size());
+        if (!result)
+            return 0;
+        Py_ssize_t idx = 0;
+        for (typename Container::const_iterator it = cppContainer->begin(); it != cppContainer->end(); ++it, ++idx) {
+            PyObject* pyKey = KeyConverter::toPython(converters[0], it->first);
+            if (!pyKey) {
+                Py_DECREF(result);
+                return 0;
+            }
+            PyList_SET_ITEM(result, idx, pyKey);
+        }
+        return result;
+    }
+
+    static PyObject* copy(const void* container, SbkConverter* const* converters)
+    {
+        const Container* cppContainer = static_cast<const Container*>(container);
+        PyObject* result = PyDict_New();
+        if (!result)
+            return 0;
+        for (typename Container::const_iterator it = cppContainer->begin(); it != cppContainer->end(); ++it) {
+            PyObject* pyKey = KeyConverter::toPython(converters[0], it->first);
+            PyObject* pyValue = pyKey ? ValueConverter::toPython(converters[1], it->second) : 0;
+            bool ok = pyValue && PyDict_SetItem(result, pyKey, pyValue) == 0;
+            Py_XDECREF(pyKey);
+            Py_XDECREF(pyValue);
+            if (!ok) {
+                Py_DECREF(result);
+                return 0;
+            }
+        }
+        return result;
+    }
+
+    static PyObject* nextKey(void* state)
+    {
+        IterationState<Container>* it = static_cast<IterationState<Container>*>(state);
+        typename Container::const_iterator item;
+        if (!it->next(&item))
+            return 0;
+        return KeyConverter::toPython(it->converter, item->first);
+    }
+
+    static PyObject* iterate(PyObject* owner, const void* container, SbkConverter* const* converters)
+    {
+        return Iterator::create(owner, IterationState<Container>::create(container, converters[0]),
+                                &nextKey, &IterationState<Container>::destroy);
+    }
+
+    static const ViewOperations* operations()
+    {
+        static const ViewOperations ops = { &size, 0, &lookup, &keys, &copy, &iterate };
+        return &ops;
+    }
+};
+
+/**
+ * Returns a read only Python sequence over the items of \p container, converted to Python
+ * with \p itemConverter only when accessed. The view keeps a reference to \p owner, the
+ * wrapper of the object holding the container, and its copy() method returns a list.
+ */
+template<typename Container>
+PyObject* newSequence(PyObject* owner, const Container* container, SbkConverter* itemConverter)
+{
+    return newView(&SbkSequenceView_Type, owner, container,
+                   SequenceOperations<Container>::operations(), itemConverter, 0);
+}
+
+/**
+ * Returns a read only Python mapping over the items of \p container, with keys and values
+ * converted with \p keyConverter and \p valueConverter only when accessed. The view keeps
+ * a reference to \p owner, and its copy() method returns a dict.
+ */
+template<typename Container>
+PyObject* newMapping(PyObject* owner, const Container* container,
+                     SbkConverter* keyConverter, SbkConverter* valueConverter)
+{
+    return newView(&SbkMappingView_Type, owner, container,
+                   MappingOperations<Container>::operations(), keyConverter, valueConverter);
+}
+
+} // namespace ContainerView
+
+} // namespace Shiboken
+
+#endif // SBKCONTAINERVIEW_H
@@ -26,10 +26,34 @@
 #include "google/dense_hash_map"
 #include "autodecref.h"
 #include "sbkdbg.h"
+#include <cstring>
 
 static SbkConverter** PrimitiveTypeConverters;
 
-typedef google::dense_hash_map<std::string, SbkConverter*> ConvertersMap;
+// Converter names are C strings with static storage duration (literals from the
+// generated code or typeid names), so they are used as keys without copying them
+// into std::string objects, both on registration and on lookup.
+struct ConverterNameHash
+{
+    size_t operator()(const char* name) const
+    {
+        // FNV-1a
+        size_t hash = 2166136261u;
+        for (; *name; ++name)
+            hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+        return hash;
+    }
+};
+
+struct ConverterNameEqual
+{
+    bool operator()(const char* a, const char* b) const
+    {
+        return a == b || std::strcmp(a, b) == 0;
+    }
+};
+
+typedef google::dense_hash_map<const char*, SbkConverter*, ConverterNameHash, ConverterNameEqual> ConvertersMap;
 static ConvertersMap converters;
 
 namespace Shiboken {
@@ -311,8 +335,22 @@ bool isImplicitConversion(SbkObjectType* type, PythonToCppFunc toCppFunc)
 void registerConverterName(SbkConverter* converter , const char* typeName)
 {
     ConvertersMap::iterator iter = converters.find(typeName);
-    if (iter == converters.end())
-        converters.insert(std::make_pair(typeName, converter));
+    if (iter != converters.end())
+        return;
+    // The caller's string may be a temporary, so keep a copy of it.
+    size_t size = std::strlen(typeName) + 1;
+    char* name = new char[size];
+    std::memcpy(name, typeName, size);
+    converters.insert(std::make_pair(name, converter));
+}
+
+void registerConverterNames(SbkConverter* converter, const char* const* typeNames)
+{
+    for (; *typeNames; ++typeNames) {
+        ConvertersMap::iterator iter = converters.find(*typeNames);
+        if (iter == converters.end())
+            converters.insert(std::make_pair(*typeNames, converter));
+    }
 }
 
 SbkConverter* getConverter(const char* typeName)
@@ -330,18 +368,63 @@ SbkConverter* primitiveTypeConverter(int index)
     return PrimitiveTypeConverters[index];
 }
 
+static bool checkItemTypes(PyTypeObject* type, PyObject* pyIn)
+{
+    AutoDecRef seq(PySequence_Fast(pyIn, 0));
+    if (seq.isNull()) {
+        PyErr_Clear();
+        return false;
+    }
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(seq.object());
+    PyObject** items = PySequence_Fast_ITEMS(seq.object());
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        if (!PyObject_TypeCheck(items[i], type))
+            return false;
+    }
+    return true;
+}
+static bool convertibleItemTypes(SbkConverter* converter, PyObject* pyIn)
+{
+    AutoDecRef seq(PySequence_Fast(pyIn, 0));
+    if (seq.isNull()) {
+        PyErr_Clear();
+        return false;
+    }
+    // Items that are exact instances of a wrapped type need no converter lookup.
+    PyTypeObject* exactType = converter->pointerToPython ? converter->pythonType : 0;
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(seq.object());
+    PyObject** items = PySequence_Fast_ITEMS(seq.object());
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        if (Py_TYPE(items[i]) == exactType)
+            continue;
+        if (!isPythonToCppConvertible(converter, items[i]))
+            return false;
+    }
+    return true;
+}
+// Sequences, sets and other iterables that can be walked more than once, unlike iterators.
+static bool isIterable(PyObject* pyIn)
+{
+    if (PySequence_Check(pyIn) || PyAnySet_Check(pyIn))
+        return true;
+    if (PyIter_Check(pyIn))
+        return false;
+    PyObject* iterator = PyObject_GetIter(pyIn);
+    if (!iterator) {
+        PyErr_Clear();
+        return false;
+    }
+    Py_DECREF(iterator);
+    return true;
+}
+
 bool checkSequenceTypes(PyTypeObject* type, PyObject* pyIn)
 {
     assert(type);
     assert(pyIn);
     if (!PySequence_Check(pyIn))
         return false;
-    int size = PySequence_Size(pyIn);
-    for (int i = 0; i < size; ++i) {
-        if (!PyObject_TypeCheck(AutoDecRef(PySequence_GetItem(pyIn, i)), type))
-            return false;
-    }
-    return true;
+    return checkItemTypes(type, pyIn);
 }
 bool convertibleSequenceTypes(SbkConverter* converter, PyObject* pyIn)
 {
@@ -349,12 +432,7 @@ bool convertibleSequenceTypes(SbkConverter* converter, PyObject* pyIn)
     assert(pyIn);
     if (!PySequence_Check(pyIn))
         return false;
-    int size = PySequence_Size(pyIn);
-    for (int i = 0; i < size; ++i) {
-        if (!isPythonToCppConvertible(converter, AutoDecRef(PySequence_GetItem(pyIn, i))))
-            return false;
-    }
-    return true;
+    return convertibleItemTypes(converter, pyIn);
 }
 bool convertibleSequenceTypes(SbkObjectType* type, PyObject* pyIn)
 {
@@ -362,6 +440,28 @@ bool convertibleSequenceTypes(SbkObjectType* type, PyObject* pyIn)
     return convertibleSequenceTypes(type->d->converter, pyIn);
 }
 
+bool checkIterableTypes(PyTypeObject* type, PyObject* pyIn)
+{
+    assert(type);
+    assert(pyIn);
+    if (!isIterable(pyIn))
+        return false;
+    return checkItemTypes(type, pyIn);
+}
+bool convertibleIterableTypes(SbkConverter* converter, PyObject* pyIn)
+{
+    assert(converter);
+    assert(pyIn);
+    if (!isIterable(pyIn))
+        return false;
+    return convertibleItemTypes(converter, pyIn);
+}
+bool convertibleIterableTypes(SbkObjectType* type, PyObject* pyIn)
+{
+    assert(type);
+    return convertibleIterableTypes(type->d->converter, pyIn);
+}
+
 bool checkPairTypes(PyTypeObject* firstType, PyTypeObject* secondType, PyObject* pyIn)
 {
     assert(firstType);
@@ -252,6 +252,14 @@ LIBSHIBOKEN_API bool isImplicitConversion(SbkObjectType* type, PythonToCppFunc t
 /// Registers a converter with a type name that may be used to retrieve the converter.
 LIBSHIBOKEN_API void registerConverterName(SbkConverter* converter, const char* typeName);
 
+/**
+ *  Registers a converter with all the type names in the NULL terminated array \p typeNames.
+ *  The names themselves are not copied, so they must live as long as the converter
+ *  (string literals and typeid names are the expected input); this is what generated
+ *  modules use to register every name variation of a type in one go.
+ */
+LIBSHIBOKEN_API void registerConverterNames(SbkConverter* converter, const char* const* typeNames);
+
 /// Returns the converter for a given type name, or NULL if it wasn't registered before.
 LIBSHIBOKEN_API SbkConverter* getConverter(const char* typeName);
 
@@ -267,6 +275,19 @@ LIBSHIBOKEN_API bool convertibleSequenceTypes(SbkConverter* converter, PyObject*
 /// Returns true if a Python sequence is comprised of objects of a type convertible to \p type.
 LIBSHIBOKEN_API bool convertibleSequenceTypes(SbkObjectType* type, PyObject* pyIn);
 
+/**
+ *  Returns true if \p pyIn is a sequence, a set or another iterable that isn't an iterator,
+ *  comprised of objects of the given \p type. Iterators are refused because checking them
+ *  would consume their items.
+ */
+LIBSHIBOKEN_API bool checkIterableTypes(PyTypeObject* type, PyObject* pyIn);
+
+/// Returns true if \p pyIn is an iterable, as above, comprised of objects convertible by \p converter.
+LIBSHIBOKEN_API bool convertibleIterableTypes(SbkConverter* converter, PyObject* pyIn);
+
+/// Returns true if \p pyIn is an iterable, as above, comprised of objects convertible to \p type.
+LIBSHIBOKEN_API bool convertibleIterableTypes(SbkObjectType* type, PyObject* pyIn);
+
 /// Returns true if a Python sequence can be converted to a C++ pair.
 LIBSHIBOKEN_API bool checkPairTypes(PyTypeObject* firstType, PyTypeObject* secondType, PyObject* pyIn);
 
@@ -386,11 +386,11 @@ struct Primitive<const char*> : TwoPrimitive<const char*>
     }
     static void otherToCpp(PyObject* pyIn, void* cppOut)
     {
-        *((const char**)cppOut) = (const char*) Shiboken::String::toCString(pyIn);
+        *((const char**)cppOut) = Shiboken::String::toCharBuffer(pyIn);
     }
     static PythonToCppFunc isOtherConvertible(PyObject* pyIn)
     {
-        if (Shiboken::String::check(pyIn))
+        if (Shiboken::String::checkCharBuffer(pyIn))
             return otherToCpp;
         return 0;
     }
@@ -415,7 +415,9 @@ struct Primitive<std::string> : TwoPrimitive<std::string>
     }
     static void otherToCpp(PyObject* pyIn, void* cppOut)
     {
-        *((std::string*)cppOut) = Shiboken::String::toCString(pyIn);
+        Py_ssize_t len = 0;
+        const char* str = Shiboken::String::toCString(pyIn, &len);
+        *((std::string*)cppOut) = str ? std::string(str, len) : std::string();
     }
     static PythonToCppFunc isOtherConvertible(PyObject* pyIn)
     {
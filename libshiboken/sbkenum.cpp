@@ -392,6 +392,13 @@ private:
 
 namespace Enum {
 
+// Name of the enum type dictionary entry holding its items.
+static PyObject* valuesName()
+{
+    static PyObject* const name = String::createStaticString("values");
+    return name;
+}
+
 bool check(PyObject* pyObj)
 {
     return Py_TYPE(pyObj->ob_type) == &SbkEnumType_Type;
@@ -401,7 +408,7 @@ PyObject* getEnumItemFromValue(PyTypeObject* enumType, long itemValue)
 {
     PyObject *key, *value;
     Py_ssize_t pos = 0;
-    PyObject* values = PyDict_GetItemString(enumType->tp_dict, const_cast<char*>("values"));
+    PyObject* values = PyDict_GetItem(enumType->tp_dict, valuesName());
 
     while (PyDict_Next(values, &pos, &key, &value)) {
         SbkEnumObject* obj = (SbkEnumObject*)value;
@@ -501,10 +508,10 @@ PyObject* newItem(PyTypeObject* enumType, long itemValue, const char* itemName)
     enumObj->ob_value = itemValue;
 
     if (newValue) {
-        PyObject* values = PyDict_GetItemString(enumType->tp_dict, const_cast<char*>("values"));
+        PyObject* values = PyDict_GetItem(enumType->tp_dict, valuesName());
         if (!values) {
             values = PyDict_New();
-            PyDict_SetItemString(enumType->tp_dict, const_cast<char*>("values"), values);
+            PyDict_SetItem(enumType->tp_dict, valuesName(), values);
             Py_DECREF(values); // ^ values still alive, because setitemstring incref it
         }
         PyDict_SetItemString(values, itemName, reinterpret_cast<PyObject*>(enumObj));
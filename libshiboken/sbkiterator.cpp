@@ -0,0 +1,139 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "sbkiterator.h"
+#include "basewrapper.h"
+
+extern "C"
+{
+
+struct SbkIterator
+{
+    PyObject_HEAD
+    PyObject* container;
+    void* state;
+    Shiboken::Iterator::NextFunction next;
+    Shiboken::Iterator::DeleteFunction deleter;
+};
+
+static void SbkIteratorDealloc(PyObject* pyObj)
+{
+    SbkIterator* self = reinterpret_cast<SbkIterator*>(pyObj);
+    if (self->state)
+        self->deleter(self->state);
+    Py_XDECREF(self->container);
+    PyObject_Del(pyObj);
+}
+
+static PyObject* SbkIteratorNext(PyObject* pyObj)
+{
+    SbkIterator* self = reinterpret_cast<SbkIterator*>(pyObj);
+    if (!self->state)
+        return 0;
+    // The C++ iterators point into the container's C++ object, which may have been deleted.
+    if (!Shiboken::Object::isValid(self->container, true))
+        return 0;
+    PyObject* item = self->next(self->state);
+    // Exhausted iterators release the C++ iterators and the container right away.
+    if (!item && !PyErr_Occurred()) {
+        self->deleter(self->state);
+        self->state = 0;
+        Py_CLEAR(self->container);
+    }
+    return item;
+}
+
+PyTypeObject SbkIterator_Type = {
+    PyVarObject_HEAD_INIT(0, 0)
+    /*tp_name*/             "Shiboken.Iterator",
+    /*tp_basicsize*/        sizeof(SbkIterator),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkIteratorDealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             0,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      0,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Iterator over a range of a C++ object.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      0,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             PyObject_SelfIter,
+    /*tp_iternext*/         SbkIteratorNext,
+    /*tp_methods*/          0,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
+namespace Shiboken
+{
+
+namespace Iterator
+{
+
+PyObject* create(PyObject* container, void* state, NextFunction next, DeleteFunction deleter)
+{
+    SbkIterator* self = PyObject_New(SbkIterator, &SbkIterator_Type);
+    if (!self) {
+        deleter(state);
+        return 0;
+    }
+    self->container = container;
+    Py_XINCREF(container);
+    self->state = state;
+    self->next = next;
+    self->deleter = deleter;
+    return reinterpret_cast<PyObject*>(self);
+}
+
+} // namespace Iterator
+
+} // namespace Shiboken
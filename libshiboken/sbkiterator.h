@@ -0,0 +1,64 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef SBKITERATOR_H
+#define SBKITERATOR_H
+
+#include "sbkpython.h"
+#include "shibokenmacros.h"
+
+extern "C"
+{
+
+/// Python type of the iterators over the ranges of C++ objects, e.g. the items of a std::list.
+extern LIBSHIBOKEN_API PyTypeObject SbkIterator_Type;
+
+} // extern "C"
+
+namespace Shiboken
+{
+
+namespace Iterator
+{
+
+/**
+ * Returns a new reference to the Python version of the item at the current position of the C++
+ * iterators in \p state and advances them, or NULL when the end was reached or on error.
+ */
+typedef PyObject* (*NextFunction)(void* state);
+/// Deletes the C++ iterators in \p state.
+typedef void (*DeleteFunction)(void* state);
+
+/**
+ * Creates a Python iterator over a range of the C++ object wrapped by \p container, which is kept
+ * alive while the iterator exists. Items are converted one at a time by \p next, when requested.
+ * Iterating raises a RuntimeError once the C++ object of \p container is deleted.
+ * \param state the C++ iterators, owned by the Python iterator and deleted by \p deleter.
+ */
+LIBSHIBOKEN_API PyObject* create(PyObject* container, void* state, NextFunction next, DeleteFunction deleter);
+
+} // namespace Iterator
+
+} // namespace Shiboken
+
+#endif // SBKITERATOR_H
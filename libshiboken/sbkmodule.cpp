@@ -23,6 +23,8 @@
 #include "sbkmodule.h"
 #include "basewrapper.h"
 #include "bindingmanager.h"
+#include "sbkconverter.h"
+#include "sbkcapi.h"
 
 // TODO: for performance reasons this should be a sparse_hash_map,
 // because there'll be very few modules as keys. The sparse_hash_map
@@ -104,4 +106,90 @@ SbkConverter** getTypeConverters(PyObject* module)
     return (iter == moduleConverters.end()) ? 0 : iter->second;
 }
 
+// Functions exported through the C API.
+
+static void* capiCppPointer(PyObject* pyIn, PyTypeObject* type)
+{
+    if (!PyObject_TypeCheck(pyIn, type)) {
+        PyErr_Format(PyExc_TypeError, "'%s' object is not a '%s'.", Py_TYPE(pyIn)->tp_name, type->tp_name);
+        return 0;
+    }
+    if (!Object::isValid(pyIn, true))
+        return 0;
+    return Object::cppPointer(reinterpret_cast<SbkObject*>(pyIn), type);
+}
+
+static PyObject* capiPointerToPython(PyTypeObject* type, const void* cppIn)
+{
+    return Conversions::pointerToPython(reinterpret_cast<SbkObjectType*>(type), cppIn);
+}
+
+static PyObject* capiReferenceToPython(PyTypeObject* type, const void* cppIn)
+{
+    return Conversions::referenceToPython(reinterpret_cast<SbkObjectType*>(type), cppIn);
+}
+
+static PyObject* capiCopyToPython(PyTypeObject* type, const void* cppIn)
+{
+    return Conversions::copyToPython(reinterpret_cast<SbkObjectType*>(type), cppIn);
+}
+
+static int capiPythonToCppCopy(PyTypeObject* type, PyObject* pyIn, void* cppOut)
+{
+    PythonToCppFunc toCpp = Conversions::isPythonToCppValueConvertible(reinterpret_cast<SbkObjectType*>(type), pyIn);
+    if (!toCpp) {
+        PyErr_Format(PyExc_TypeError, "'%s' object can't be converted to '%s'", Py_TYPE(pyIn)->tp_name, type->tp_name);
+        return 0;
+    }
+    toCpp(pyIn, cppOut);
+    return !PyErr_Occurred();
+}
+
+static PyObject* capiConverterToPython(SbkConverter* converter, const void* cppIn)
+{
+    return Conversions::copyToPython(converter, cppIn);
+}
+
+static int capiConverterToCpp(SbkConverter* converter, PyObject* pyIn, void* cppOut)
+{
+    PythonToCppFunc toCpp = Conversions::isPythonToCppConvertible(converter, pyIn);
+    if (!toCpp) {
+        PyErr_Format(PyExc_TypeError, "'%s' object can't be converted", Py_TYPE(pyIn)->tp_name);
+        return 0;
+    }
+    toCpp(pyIn, cppOut);
+    return !PyErr_Occurred();
+}
+
+void exportCApi(PyObject* module, const char* capsuleName, int typeCount, int converterCount)
+{
+    // Lives as long as the module, i.e. until the interpreter finalization.
+    SbkCApi* api = new SbkCApi;
+    api->version = SBK_C_API_VERSION;
+    api->types = getTypes(module);
+    api->typeCount = api->types ? typeCount : 0;
+    api->converters = getTypeConverters(module);
+    api->converterCount = api->converters ? converterCount : 0;
+    api->cppPointer = &capiCppPointer;
+    api->pointerToPython = &capiPointerToPython;
+    api->referenceToPython = &capiReferenceToPython;
+    api->copyToPython = &capiCopyToPython;
+    api->pythonToCppCopy = &capiPythonToCppCopy;
+    api->converterToPython = &capiConverterToPython;
+    api->converterToCpp = &capiConverterToCpp;
+
+#ifdef IS_PY3K
+    PyObject* capsule = PyCapsule_New(api, capsuleName, 0);
+#else
+    // Python 2.6 doesn't have PyCapsule API, so let's keep using PyCObject on all Python 2.x
+    PyObject* capsule = PyCObject_FromVoidPtr(api, 0);
+    (void) capsuleName;
+#endif
+    if (!capsule) {
+        delete api;
+        return;
+    }
+    PyModule_AddObject(module, "_C_API", capsule);
+}
+
 } } // namespace Shiboken::Module
@@ -93,6 +93,17 @@ LIBSHIBOKEN_API void registerTypeConverters(PyObject* module, SbkConverter** con
  */
 LIBSHIBOKEN_API SbkConverter** getTypeConverters(PyObject* module);
 
+/**
+ *  Adds to \p module a "_C_API" capsule holding the SbkCApi structure declared in sbkcapi.h,
+ *  which gives C extensions access to the types and converters registered by the module.
+ *  Must be called after registerTypes() and registerTypeConverters().
+ *  \param module          Module where the types and converters were created.
+ *  \param capsuleName     Name of the capsule, e.g. "sample._C_API"; it must outlive the module.
+ *  \param typeCount       Number of items in the array of types.
+ *  \param converterCount  Number of items in the array of converters.
+ */
+LIBSHIBOKEN_API void exportCApi(PyObject* module, const char* capsuleName, int typeCount, int converterCount);
+
 } } // namespace Shiboken::Module
 
 #endif // SBK_MODULE_H
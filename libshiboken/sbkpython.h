@@ -54,4 +54,11 @@
     #define Py_hash_t long
 #endif
 
+// Value returned by PyThread_start_new_thread on failure.
+#ifdef PYTHREAD_INVALID_THREAD_ID
+    #define SBK_INVALID_THREAD_ID PYTHREAD_INVALID_THREAD_ID
+#else
+    #define SBK_INVALID_THREAD_ID ((long)-1)
+#endif
+
 #endif
@@ -0,0 +1,150 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#include "sbkqueuedcalls.h"
+#include "gilstate.h"
+#include "threadstatesaver.h"
+#include <pythread.h>
+#include <list>
+
+namespace Shiboken
+{
+namespace QueuedCalls
+{
+
+typedef std::list<QueuedCall*> QueuedCallList;
+static QueuedCallList queuedCalls;
+// Protects the queue and the variables below. Producers only hold it to add their call.
+static PyThread_type_lock queueLock = 0;
+static bool processingScheduled = false;
+// Held by process() while it runs a call, cancel() waits on it when the object of the
+// running call is being deleted by another thread.
+static PyThread_type_lock runningLock = 0;
+static const void* runningCppPointer = 0;
+static long runningThread = SBK_INVALID_THREAD_ID;
+
+static int processCallback(void*)
+{
+    process();
+    return 0;
+}
+
+static bool initQueue()
+{
+    // The first producer may not hold the GIL, the local static makes the lock be created once.
+    static PyThread_type_lock lock = PyThread_allocate_lock();
+    static PyThread_type_lock callLock = PyThread_allocate_lock();
+    if (!lock || !callLock)
+        return false;
+    runningLock = callLock;
+    queueLock = lock;
+    return true;
+}
+
+void post(QueuedCall* call)
+{
+    if (!queueLock && !initQueue()) {
+        delete call;
+        return;
+    }
+    PyThread_acquire_lock(queueLock, WAIT_LOCK);
+    queuedCalls.push_back(call);
+    bool scheduled = processingScheduled;
+    if (!scheduled)
+        scheduled = processingScheduled = Py_AddPendingCall(&processCallback, 0) == 0;
+    PyThread_release_lock(queueLock);
+
+    // The interpreter's list of pending calls is full, rather than leaving the queue
+    // behind until the next post the calls are run now, waiting for the GIL.
+    if (!scheduled) {
+        GilState gil;
+        process();
+    }
+}
+
+void cancel(const void* cptr)
+{
+    if (!queueLock)
+        return;
+    QueuedCallList cancelled;
+    PyThread_acquire_lock(queueLock, WAIT_LOCK);
+    QueuedCallList::iterator it = queuedCalls.begin();
+    while (it != queuedCalls.end()) {
+        if ((*it)->cppPointer() == cptr) {
+            cancelled.push_back(*it);
+            it = queuedCalls.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    // A call on the object may be running, the object must outlive it. The thread running
+    // the call itself is not blocked, it is deleting the object from inside the call.
+    bool waitForRunningCall = runningCppPointer == cptr && runningThread != PyThread_get_thread_ident();
+    PyThread_release_lock(queueLock);
+    if (waitForRunningCall) {
+        // The running call may need the GIL to finish, it must not be held while waiting.
+        ThreadStateSaver threadSaver;
+        if (currentThreadMayHoldGil())
+            threadSaver.save();
+        PyThread_acquire_lock(runningLock, WAIT_LOCK);
+        PyThread_release_lock(runningLock);
+    }
+    for (it = cancelled.begin(); it != cancelled.end(); ++it)
+        delete *it;
+}
+
+void process()
+{
+    if (!queueLock)
+        return;
+    PyThread_acquire_lock(queueLock, WAIT_LOCK);
+    processingScheduled = false;
+    // Nested in a call, or racing with a post() that could not schedule the queue:
+    // the process() already running takes the calls as they are added.
+    if (runningThread != SBK_INVALID_THREAD_ID) {
+        PyThread_release_lock(queueLock);
+        return;
+    }
+    // Calls are taken one at a time, since running one may cancel the others.
+    while (!queuedCalls.empty()) {
+        QueuedCall* call = queuedCalls.front();
+        queuedCalls.pop_front();
+        // Marked as running while the queue is locked, so cancel() sees it either queued or running.
+        PyThread_acquire_lock(runningLock, WAIT_LOCK);
+        runningCppPointer = call->cppPointer();
+        runningThread = PyThread_get_thread_ident();
+        PyThread_release_lock(queueLock);
+        call->call();
+        if (PyErr_Occurred())
+            PyErr_Print();
+        PyThread_acquire_lock(queueLock, WAIT_LOCK);
+        runningCppPointer = 0;
+        runningThread = SBK_INVALID_THREAD_ID;
+        PyThread_release_lock(runningLock);
+        delete call;
+    }
+    PyThread_release_lock(queueLock);
+}
+
+} // namespace QueuedCalls
+} // namespace Shiboken
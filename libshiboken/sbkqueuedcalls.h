@@ -0,0 +1,72 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef SBKQUEUEDCALLS_H
+#define SBKQUEUEDCALLS_H
+
+#include "sbkpython.h"
+#include "shibokenmacros.h"
+
+namespace Shiboken
+{
+
+/**
+ *  A call made by a C++ thread unknown to Python, to be run later by a thread holding the GIL.
+ *  The generated code derives from it to keep copies of the arguments of queued virtual methods.
+ */
+class LIBSHIBOKEN_API QueuedCall
+{
+public:
+    explicit QueuedCall(const void* cptr) : m_cptr(cptr) {}
+    virtual ~QueuedCall() {}
+    /// Runs the call, with the GIL held.
+    virtual void call() = 0;
+    /// C++ object the call is made on.
+    const void* cppPointer() const { return m_cptr; }
+private:
+    const void* m_cptr;
+};
+
+namespace QueuedCalls
+{
+
+/**
+ *  Adds \p call, which is deleted once run, to the queue of calls and returns without waiting
+ *  for the GIL. The queue is processed by the interpreter as a pending call, or by process().
+ *  If the interpreter can't take another pending call, waits for the GIL and runs the queue.
+ */
+LIBSHIBOKEN_API void post(QueuedCall* call);
+
+/**
+ *  Drops the queued calls made on the C++ object \p cptr, which is being deleted. If a call on
+ *  it is running in another thread, waits for it to finish.
+ */
+LIBSHIBOKEN_API void cancel(const void* cptr);
+
+/// Runs the queued calls, in the order they were posted. Must be called with the GIL held.
+LIBSHIBOKEN_API void process();
+
+} // namespace QueuedCalls
+} // namespace Shiboken
+
+#endif // SBKQUEUEDCALLS_H
@@ -0,0 +1,106 @@
+/*
+* This file is part of the Shiboken Python Bindings Generator project.
+*
+* Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+*
+* Contact: PySide team <contact@pyside.org>
+*
+* This library is free software; you can redistribute it and/or
+* modify it under the terms of the GNU Lesser General Public
+* License as published by the Free Software Foundation; either
+* version 2.1 of the License, or (at your option) any later version.
+*
+* This library is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+* Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this library; if not, write to the Free Software
+* Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+#ifndef SBKSMARTPOINTER_H
+#define SBKSMARTPOINTER_H
+
+#include "sbkpython.h"
+#include "basewrapper.h"
+#include "bindingmanager.h"
+#include "conversions.h"
+#include <typeinfo>
+
+namespace Shiboken
+{
+
+/**
+ *  Converts smart pointers to wrapped objects, like std::tr1::shared_ptr<T>, boost::shared_ptr<T> or
+ *  intrusive pointers, to Python and back. \p SmartPointer must be copyable, define element_type and
+ *  provide get().
+ *
+ *  The wrapper of the pointee keeps a copy of the smart pointer instead of owning the C++ object, so
+ *  the object lives while Python or C++ use it. There's a single wrapper per C++ object, found by the
+ *  BindingManager through the raw pointer, and converting it back to C++ just copies the smart pointer.
+ *  Objects created and owned by Python are adopted by a new smart pointer when first converted.
+ */
+template<typename SmartPointer>
+struct SmartPointerConverter
+{
+    typedef typename SmartPointer::element_type T;
+
+    static const char* holderType() { return typeid(SmartPointer).name(); }
+
+    static void deleteHolder(void* holder) { delete reinterpret_cast<SmartPointer*>(holder); }
+
+    static PyObject* toPython(const SmartPointer& cppIn)
+    {
+        T* cptr = cppIn.get();
+        if (!cptr)
+            Py_RETURN_NONE;
+        SbkObject* wrapper = BindingManager::instance().retrieveWrapper(cptr);
+        if (wrapper) {
+            // A wrapper not owned by Python, e.g. returned as a raw pointer before, starts sharing the object.
+            if (!Object::hasOwnership(wrapper) && !Object::holder(wrapper, holderType()))
+                Object::setHolder(wrapper, new SmartPointer(cppIn), holderType(), &deleteHolder);
+            Py_INCREF(wrapper);
+            return reinterpret_cast<PyObject*>(wrapper);
+        }
+        PyObject* pyOut = Object::newObject(reinterpret_cast<SbkObjectType*>(SbkType<T>()), cptr, false);
+        if (pyOut)
+            Object::setHolder(reinterpret_cast<SbkObject*>(pyOut), new SmartPointer(cppIn), holderType(), &deleteHolder);
+        return pyOut;
+    }
+
+    static bool isConvertible(PyObject* pyIn)
+    {
+        return pyIn == Py_None || PyObject_TypeCheck(pyIn, SbkType<T>());
+    }
+
+    /// Returns a null smart pointer and sets a Python exception if \p pyIn can't be shared.
+    static SmartPointer toCpp(PyObject* pyIn)
+    {
+        if (pyIn == Py_None)
+            return SmartPointer();
+        if (!PyObject_TypeCheck(pyIn, SbkType<T>()) || !Object::isValid(pyIn)) {
+            if (!PyErr_Occurred())
+                PyErr_Format(PyExc_TypeError, "'%s' object is not a '%s'.", Py_TYPE(pyIn)->tp_name, SbkType<T>()->tp_name);
+            return SmartPointer();
+        }
+        SbkObject* wrapper = reinterpret_cast<SbkObject*>(pyIn);
+        if (SmartPointer* holder = reinterpret_cast<SmartPointer*>(Object::holder(wrapper, holderType())))
+            return *holder;
+        if (!Object::hasOwnership(wrapper)) {
+            PyErr_Format(PyExc_TypeError, "The C++ object wrapped by this '%s' object is owned by C++ and can't be shared.",
+                         Py_TYPE(pyIn)->tp_name);
+            return SmartPointer();
+        }
+        T* cptr = reinterpret_cast<T*>(Object::cppPointer(wrapper, SbkType<T>()));
+        SmartPointer* holder = new SmartPointer(cptr);
+        Object::setHolder(wrapper, holder, holderType(), &deleteHolder);
+        return *holder;
+    }
+};
+
+} // namespace Shiboken
+
+#endif // SBKSMARTPOINTER_H
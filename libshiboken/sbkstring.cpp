@@ -84,14 +84,13 @@ const char* toCString(PyObject* str, Py_ssize_t* len)
         return NULL;
 #ifdef IS_PY3K
     if (PyUnicode_Check(str)) {
-        if (len) {
-            // We need to encode the unicode string into utf8 to know the size of returned char*.
-            Shiboken::AutoDecRef uniStr(PyUnicode_AsUTF8String(str));
-            *len = PyBytes_GET_SIZE(uniStr.object());
-        }
-        // Return unicode from str instead of uniStr, because the lifetime of the returned pointer
-        // depends on the lifetime of str.
-        return _PyUnicode_AsString(str);
+        // Use the UTF-8 representation cached in the unicode object itself, so the string
+        // is encoded only once and the returned pointer lives as long as str.
+#if PY_VERSION_HEX >= 0x03030000
+        return PyUnicode_AsUTF8AndSize(str, len);
+#else
+        return _PyUnicode_AsStringAndSize(str, len);
+#endif
     }
 #endif
     if (PyBytes_Check(str)) {
@@ -99,9 +98,58 @@ const char* toCString(PyObject* str, Py_ssize_t* len)
             *len = PyBytes_GET_SIZE(str);
         return PyBytes_AS_STRING(str);
     }
+    if (PyByteArray_Check(str)) {
+        if (len)
+            *len = PyByteArray_GET_SIZE(str);
+        return PyByteArray_AS_STRING(str);
+    }
+    return 0;
+}
+
+bool checkCharBuffer(PyObject* obj)
+{
+    return check(obj) || PyBytes_Check(obj) || PyByteArray_Check(obj);
+}
+
+const char* toCharBuffer(PyObject* obj, Py_ssize_t* len)
+{
+    if (checkCharBuffer(obj))
+        return toCString(obj, len);
+    if (len)
+        *len = 0;
     return 0;
 }
 
+bool CharBuffer::check(PyObject* obj)
+{
+    return checkCharBuffer(obj) || PyObject_CheckBuffer(obj);
+}
+
+CharBuffer::CharBuffer(PyObject* obj) : m_data(0), m_size(0), m_hasView(false)
+{
+    if (checkCharBuffer(obj)) {
+        m_data = toCharBuffer(obj, &m_size);
+        if (!m_data)
+            m_size = 0;
+        return;
+    }
+    if (PyObject_CheckBuffer(obj)) {
+        if (PyObject_GetBuffer(obj, &m_view, PyBUF_SIMPLE) == 0) {
+            m_hasView = true;
+            m_data = reinterpret_cast<const char*>(m_view.buf);
+            m_size = m_view.len;
+        } else {
+            PyErr_Clear();
+        }
+    }
+}
+
+CharBuffer::~CharBuffer()
+{
+    if (m_hasView)
+        PyBuffer_Release(&m_view);
+}
+
 bool concat(PyObject** val1, PyObject* val2)
 {
     if (PyUnicode_Check(*val1) && PyUnicode_Check(val2)) {
@@ -167,6 +215,37 @@ int compare(PyObject* val1, const char* val2)
 
 }
 
+PyObject* createStaticString(const char* str)
+{
+#ifdef IS_PY3K
+    return PyUnicode_InternFromString(str);
+#else
+    return PyString_InternFromString(str);
+#endif
+}
+
+bool createStaticStrings(PyObject** strings, const char** names)
+{
+    for (int i = 0; names[i]; ++i) {
+        strings[i] = createStaticString(names[i]);
+        if (!strings[i])
+            return false;
+    }
+    return true;
+}
+
+bool isInterned(PyObject* str)
+{
+#if PY_VERSION_HEX >= 0x03030000
+    return PyUnicode_Check(str) && PyUnicode_CHECK_INTERNED(str);
+#elif defined(IS_PY3K)
+    // Unknown, so strings are compared by contents.
+    return false;
+#else
+    return PyString_Check(str) && PyString_CHECK_INTERNED(str);
+#endif
+}
+
 Py_ssize_t len(PyObject* str)
 {
     if (str == Py_None)
@@ -43,11 +43,71 @@ namespace String
     LIBSHIBOKEN_API PyObject* fromCString(const char* value);
     LIBSHIBOKEN_API PyObject* fromCString(const char* value, int len);
     LIBSHIBOKEN_API const char* toCString(PyObject* str, Py_ssize_t* len = 0);
+    /// Returns true if \p obj is a string, a bytes or a bytearray object.
+    LIBSHIBOKEN_API bool checkCharBuffer(PyObject* obj);
+    /**
+     *  Returns a pointer to the NUL terminated contents of any object accepted by
+     *  checkCharBuffer(), and stores its size in bytes in \p len. No copy is made: the
+     *  pointer stays valid while \p obj is alive and not resized. Returns 0 for other objects.
+     */
+    LIBSHIBOKEN_API const char* toCharBuffer(PyObject* obj, Py_ssize_t* len = 0);
+
+    /**
+     *  Reads the contents of the objects accepted by checkCharBuffer(), and of any buffer
+     *  protocol exporter, whose view is held while the CharBuffer exists. The data of an
+     *  exporter is not NUL terminated, so it is meant for (data, size) arguments.
+     */
+    class LIBSHIBOKEN_API CharBuffer
+    {
+    public:
+        /// Returns true if the contents of \p obj can be read by a CharBuffer.
+        static bool check(PyObject* obj);
+
+        explicit CharBuffer(PyObject* obj);
+        ~CharBuffer();
+
+        /// Returns the contents of the object, or 0 if they couldn't be read.
+        const char* data() const { return m_data; }
+        Py_ssize_t size() const { return m_size; }
+
+    private:
+        CharBuffer(const CharBuffer&);
+        CharBuffer& operator=(const CharBuffer&);
+
+        const char* m_data;
+        Py_ssize_t m_size;
+        bool m_hasView;
+        Py_buffer m_view;
+    };
+
     LIBSHIBOKEN_API bool concat(PyObject** val1, PyObject* val2);
     LIBSHIBOKEN_API PyObject* fromFormat(const char* format, ...);
     LIBSHIBOKEN_API PyObject* fromStringAndSize(const char* str, Py_ssize_t size);
     LIBSHIBOKEN_API int compare(PyObject* val1, const char* val2);
     LIBSHIBOKEN_API Py_ssize_t len(PyObject* str);
+    /**
+     *  Returns an interned string with the contents of \p str, that is never released.
+     *  Meant to be created once and kept in a static variable, e.g. for attribute names.
+     */
+    LIBSHIBOKEN_API PyObject* createStaticString(const char* str);
+    /**
+     *  Fills the \p strings table with static strings made from the NULL terminated \p names
+     *  array. Binding modules call it once at initialization to create the strings their
+     *  generated code looks up, and refer to them by index afterwards.
+     *  Returns false, with a Python exception set, if a string couldn't be created.
+     */
+    LIBSHIBOKEN_API bool createStaticStrings(PyObject** strings, const char** names);
+    /// Returns true if \p str is an interned string.
+    LIBSHIBOKEN_API bool isInterned(PyObject* str);
+    /**
+     *  Returns true if \p str is equal to \p staticStr, a string made by createStaticString.
+     *  Interned strings, like attribute names written in Python code, are equal only if they are
+     *  the same object, so only strings built at runtime have their contents compared.
+     */
+    inline bool equalsStatic(PyObject* str, PyObject* staticStr)
+    {
+        return str == staticStr || (!isInterned(str) && compare(str, toCString(staticStr)) == 0);
+    }
 
 } // namespace String
 } // namespace Shiboken
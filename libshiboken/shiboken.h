@@ -38,6 +38,12 @@
 #include "shibokenmacros.h"
 #include "typeresolver.h"
 #include "shibokenbuffer.h"
+#include "sbkcontainerview.h"
+#include "sbkasync.h"
+#include "sbkqueuedcalls.h"
+#include "sbkcall.h"
+#include "sbksmartpointer.h"
+#include "sbkiterator.h"
 
 #endif // SHIBOKEN_H
 
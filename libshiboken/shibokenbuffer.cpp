@@ -24,6 +24,181 @@
 #include <cstdlib>
 #include <cstring>
 
+extern "C"
+{
+
+struct SbkBuffer
+{
+    PyObject_HEAD
+    void* memory;
+    Py_ssize_t len;
+    Py_ssize_t itemSize;
+    char* format;
+    int ndim;
+    // Holds ndim shape entries followed by ndim strides entries.
+    Py_ssize_t* shapeAndStrides;
+    bool cContiguous;
+    bool fContiguous;
+    bool readonly;
+    PyObject* owner;
+};
+
+static void SbkBufferDealloc(PyObject* pyObj)
+{
+    SbkBuffer* self = reinterpret_cast<SbkBuffer*>(pyObj);
+    Py_XDECREF(self->owner);
+    PyMem_Free(self->format);
+    PyMem_Free(self->shapeAndStrides);
+    PyObject_Del(pyObj);
+}
+
+static int SbkBufferGetBuffer(PyObject* pyObj, Py_buffer* view, int flags)
+{
+    SbkBuffer* self = reinterpret_cast<SbkBuffer*>(pyObj);
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && self->readonly) {
+        PyErr_SetString(PyExc_BufferError, "Object is not writable.");
+        view->obj = 0;
+        return -1;
+    }
+    if (!self->cContiguous && (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        PyErr_SetString(PyExc_BufferError, "Object is not contiguous, strides are required to access it.");
+        view->obj = 0;
+        return -1;
+    }
+    if (((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS && !self->cContiguous)
+        || ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS && !self->fContiguous)
+        || ((flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS && !self->cContiguous && !self->fContiguous)) {
+        PyErr_SetString(PyExc_BufferError, "Object does not have the requested contiguity.");
+        view->obj = 0;
+        return -1;
+    }
+
+    Py_INCREF(pyObj);
+    view->obj = pyObj;
+    view->buf = self->memory;
+    view->len = self->len;
+    view->readonly = self->readonly;
+    view->itemsize = self->itemSize;
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? self->format : 0;
+    if ((flags & PyBUF_ND) == PyBUF_ND) {
+        view->ndim = self->ndim;
+        view->shape = self->shapeAndStrides;
+    } else {
+        view->ndim = 1;
+        view->shape = 0;
+    }
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->shapeAndStrides + self->ndim : 0;
+    view->suboffsets = 0;
+    view->internal = 0;
+    return 0;
+}
+
+#ifndef IS_PY3K
+static Py_ssize_t SbkBufferGetReadBuffer(PyObject* pyObj, Py_ssize_t segment, void** ptrptr)
+{
+    SbkBuffer* self = reinterpret_cast<SbkBuffer*>(pyObj);
+    if (segment != 0) {
+        PyErr_SetString(PyExc_SystemError, "Accessing non-existent buffer segment.");
+        return -1;
+    }
+    if (!self->cContiguous) {
+        PyErr_SetString(PyExc_TypeError, "Object is not contiguous.");
+        return -1;
+    }
+    *ptrptr = self->memory;
+    return self->len;
+}
+
+static Py_ssize_t SbkBufferGetWriteBuffer(PyObject* pyObj, Py_ssize_t segment, void** ptrptr)
+{
+    if (reinterpret_cast<SbkBuffer*>(pyObj)->readonly) {
+        PyErr_SetString(PyExc_TypeError, "Object is not writable.");
+        return -1;
+    }
+    return SbkBufferGetReadBuffer(pyObj, segment, ptrptr);
+}
+
+static Py_ssize_t SbkBufferGetSegCount(PyObject* pyObj, Py_ssize_t* lenp)
+{
+    if (lenp)
+        *lenp = reinterpret_cast<SbkBuffer*>(pyObj)->len;
+    return 1;
+}
+
+static Py_ssize_t SbkBufferGetCharBuffer(PyObject* pyObj, Py_ssize_t segment, char** ptrptr)
+{
+    return SbkBufferGetReadBuffer(pyObj, segment, reinterpret_cast<void**>(ptrptr));
+}
+#endif
+
+static PyBufferProcs SbkBufferProcs = {
+#ifdef IS_PY3K
+    /*bf_getbuffer*/        SbkBufferGetBuffer,
+    /*bf_releasebuffer*/    0
+#else
+    /*bf_getreadbuffer*/    SbkBufferGetReadBuffer,
+    /*bf_getwritebuffer*/   SbkBufferGetWriteBuffer,
+    /*bf_getsegcount*/      SbkBufferGetSegCount,
+    /*bf_getcharbuffer*/    SbkBufferGetCharBuffer,
+    /*bf_getbuffer*/        SbkBufferGetBuffer,
+    /*bf_releasebuffer*/    0
+#endif
+};
+
+PyTypeObject SbkBuffer_Type = {
+    PyVarObject_HEAD_INIT(0, 0)
+    /*tp_name*/             "Shiboken.Buffer",
+    /*tp_basicsize*/        sizeof(SbkBuffer),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkBufferDealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             0,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      0,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        &SbkBufferProcs,
+#ifdef IS_PY3K
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+#else
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT|Py_TPFLAGS_HAVE_GETCHARBUFFER|Py_TPFLAGS_HAVE_NEWBUFFER,
+#endif
+    /*tp_doc*/              0,
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      0,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             0,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          0,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
 bool Shiboken::Buffer::checkType(PyObject* pyObj)
 {
     return PyObject_CheckReadBuffer(pyObj);
@@ -37,7 +212,10 @@ void* Shiboken::Buffer::getPointer(PyObject* pyObj, Py_ssize_t* size)
     if (PyObject_GetBuffer(pyObj, &view, PyBUF_ND) == 0) {
         if (size)
             *size = view.len;
-        return view.buf;
+        // The memory remains owned by pyObj, release the view to not keep it locked.
+        void* buffer = view.buf;
+        PyBuffer_Release(&view);
+        return buffer;
     } else {
         return 0;
     }
@@ -58,16 +236,7 @@ PyObject* Shiboken::Buffer::newObject(void* memory, Py_ssize_t size, Type type)
     if (size == 0)
         Py_RETURN_NONE;
 #ifdef IS_PY3K
-    Py_buffer view;
-    memset(&view, 0, sizeof(Py_buffer));
-    view.buf = memory;
-    view.len = size;
-    view.readonly = type == Shiboken::Buffer::ReadOnly;
-    view.ndim = 1;
-    view.itemsize = sizeof(char);
-    Py_ssize_t shape[] = { size };
-    view.shape = shape;
-    return PyMemoryView_FromBuffer(&view);
+    return newObject(memory, size, type, 0);
 #else
     return type == ReadOnly ? PyBuffer_FromMemory(memory, size) : PyBuffer_FromReadWriteMemory(memory, size);
 #endif
@@ -77,3 +246,157 @@ PyObject* Shiboken::Buffer::newObject(const void* memory, Py_ssize_t size)
 {
     return newObject(const_cast<void*>(memory), size, ReadOnly);
 }
+
+PyObject* Shiboken::Buffer::newObject(void* memory, Py_ssize_t size, Type type, PyObject* owner)
+{
+    return newObject(memory, "B", 1, 1, &size, 0, type, owner);
+}
+
+PyObject* Shiboken::Buffer::newObject(void* memory, const char* format, Py_ssize_t itemSize,
+                                      int ndim, const Py_ssize_t* shape, const Py_ssize_t* strides,
+                                      Type type, PyObject* owner)
+{
+    if (ndim < 1 || itemSize < 1 || !format) {
+        PyErr_SetString(PyExc_ValueError, "Invalid buffer description.");
+        return 0;
+    }
+    if (!PyType_HasFeature(&SbkBuffer_Type, Py_TPFLAGS_READY) && PyType_Ready(&SbkBuffer_Type) < 0)
+        return 0;
+
+    SbkBuffer* self = PyObject_New(SbkBuffer, &SbkBuffer_Type);
+    if (!self)
+        return 0;
+    self->memory = memory;
+    self->itemSize = itemSize;
+    self->ndim = ndim;
+    self->readonly = type == ReadOnly;
+    self->owner = owner;
+    Py_XINCREF(owner);
+
+    size_t formatSize = strlen(format) + 1;
+    self->format = reinterpret_cast<char*>(PyMem_Malloc(formatSize));
+    self->shapeAndStrides = reinterpret_cast<Py_ssize_t*>(PyMem_Malloc(2 * ndim * sizeof(Py_ssize_t)));
+    if (!self->format || !self->shapeAndStrides) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    memcpy(self->format, format, formatSize);
+
+    self->len = itemSize;
+    for (int i = 0; i < ndim; ++i) {
+        if (shape[i] < 0) {
+            Py_DECREF(self);
+            PyErr_SetString(PyExc_ValueError, "Invalid buffer description.");
+            return 0;
+        }
+        if (shape[i] > 0 && self->len > PY_SSIZE_T_MAX / shape[i]) {
+            Py_DECREF(self);
+            PyErr_SetString(PyExc_OverflowError, "Buffer size is too large.");
+            return 0;
+        }
+        self->shapeAndStrides[i] = shape[i];
+        self->len *= shape[i];
+    }
+    // Strides of a C contiguous array are computed anyway, so they are at hand
+    // for consumers asking for them.
+    self->cContiguous = true;
+    Py_ssize_t stride = itemSize;
+    for (int i = ndim - 1; i >= 0; --i) {
+        self->shapeAndStrides[ndim + i] = strides ? strides[i] : stride;
+        if (shape[i] > 1 && self->shapeAndStrides[ndim + i] != stride)
+            self->cContiguous = false;
+        stride *= shape[i];
+    }
+    self->fContiguous = true;
+    stride = itemSize;
+    for (int i = 0; i < ndim; ++i) {
+        if (shape[i] > 1 && self->shapeAndStrides[ndim + i] != stride)
+            self->fContiguous = false;
+        stride *= shape[i];
+    }
+    // Empty arrays have no layout.
+    if (self->len == 0)
+        self->cContiguous = self->fContiguous = true;
+
+#ifdef IS_PY3K
+    PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(self));
+    Py_DECREF(self);
+    return view;
+#else
+    return reinterpret_cast<PyObject*>(self);
+#endif
+}
+
+static char formatKind(const char* format, Py_ssize_t itemSize)
+{
+    if (!format)
+        return 'u';
+    if (*format == '@')
+        ++format;
+    if (!*format || format[1])
+        return 0;
+    switch (*format) {
+    case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+        return 'i';
+    case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+        return 'u';
+    case 'c':
+        return itemSize == 1 ? 'c' : 0;
+    case 'f': case 'd':
+        return 'f';
+    case '?':
+        return '?';
+    }
+    return 0;
+}
+
+bool Shiboken::Buffer::getItems(PyObject* pyObj, Py_buffer* view, char kind, Py_ssize_t itemSize)
+{
+    if (!kind || !PyObject_CheckBuffer(pyObj))
+        return false;
+    if (PyObject_GetBuffer(pyObj, view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) < 0) {
+        PyErr_Clear();
+        return false;
+    }
+    char viewKind = formatKind(view->format, view->itemsize);
+    // Bytes of type 'c' are accepted as any single byte integer.
+    if (viewKind == 'c' && (kind == 'i' || kind == 'u'))
+        viewKind = kind;
+    if (viewKind != kind || view->itemsize != itemSize) {
+        PyBuffer_Release(view);
+        return false;
+    }
+    return true;
+}
+
+PyObject* Shiboken::Buffer::newArray(char kind, Py_ssize_t itemSize, Py_ssize_t count, void** data)
+{
+    const char* format = 0;
+    if (kind == 'f') {
+        if (itemSize == sizeof(float))
+            format = "f";
+        else if (itemSize == sizeof(double))
+            format = "d";
+    } else if (kind == '?') {
+        format = "?";
+    } else if (kind == 'i' || kind == 'u') {
+        const Py_ssize_t sizes[] = { sizeof(char), sizeof(short), sizeof(int), sizeof(long), sizeof(PY_LONG_LONG) };
+        static const char* signedFormats[] = { "b", "h", "i", "l", "q" };
+        static const char* unsignedFormats[] = { "B", "H", "I", "L", "Q" };
+        for (int i = 0; i < 5 && !format; ++i) {
+            if (sizes[i] == itemSize)
+                format = kind == 'i' ? signedFormats[i] : unsignedFormats[i];
+        }
+    }
+    if (!format)
+        return 0;
+
+    // A bytearray is the owner of the storage, it isn't reachable from Python to be resized.
+    PyObject* storage = PyByteArray_FromStringAndSize(0, count * itemSize);
+    if (!storage)
+        return 0;
+    *data = PyByteArray_AS_STRING(storage);
+    PyObject* result = newObject(*data, format, itemSize, 1, &count, 0, ReadWrite, storage);
+    Py_DECREF(storage);
+    return result;
+}
@@ -25,6 +25,17 @@
 
 #include "sbkpython.h"
 #include "shibokenmacros.h"
+#include "threadstatesaver.h"
+#include <algorithm>
+#include <limits>
+
+extern "C"
+{
+
+/// Python type of the buffer objects exporting C++ memory, see Shiboken::Buffer::newObject.
+extern LIBSHIBOKEN_API PyTypeObject SbkBuffer_Type;
+
+} // extern "C"
 
 namespace Shiboken
 {
@@ -49,6 +60,28 @@ namespace Buffer
      */
     LIBSHIBOKEN_API PyObject* newObject(const void* memory, Py_ssize_t size);
 
+    /**
+     * Creates a new Python buffer pointing to a contiguous memory block at
+     * \p memory of size \p size, that keeps a reference to \p owner while alive.
+     *
+     * \p owner is the object responsible for the memory, usually the wrapper of the C++
+     * object holding it, or a PyCapsule releasing it; the memory is accessible from Python
+     * without copies for as long as any buffer or memoryview made from it exists.
+     */
+    LIBSHIBOKEN_API PyObject* newObject(void* memory, Py_ssize_t size, Type type, PyObject* owner);
+
+    /**
+     * Creates a new Python buffer exporting an \p ndim dimensional array at \p memory, whose
+     * items are described by the struct module \p format string and have \p itemSize bytes.
+     * The \p shape and \p strides arrays must have \p ndim entries each and are copied; pass
+     * a NULL \p strides for C contiguous arrays. As above, a reference to \p owner is kept.
+     *
+     * On Python 3 the buffer is returned wrapped in a memoryview.
+     */
+    LIBSHIBOKEN_API PyObject* newObject(void* memory, const char* format, Py_ssize_t itemSize,
+                                        int ndim, const Py_ssize_t* shape, const Py_ssize_t* strides,
+                                        Type type, PyObject* owner = 0);
+
     /**
      * Check if is ok to use \p pyObj as argument in all function under Shiboken::Buffer namespace.
      */
@@ -62,6 +95,89 @@ namespace Buffer
      */
     LIBSHIBOKEN_API void* getPointer(PyObject* pyObj, Py_ssize_t* size = 0);
 
+    /// Copies bigger than this number of bytes are made with the GIL released.
+    const Py_ssize_t LargeCopySize = 64 * 1024;
+
+    /**
+     * Returns a character describing the kind of number represented by the C++ type \p T in
+     * the buffer functions: 'i' for signed integers, 'u' for unsigned integers, 'f' for floating
+     * point numbers, '?' for booleans, or 0 for types which are not numbers.
+     */
+    template <typename T>
+    inline char itemKind()
+    {
+        if (!std::numeric_limits<T>::is_specialized)
+            return 0;
+        if (!std::numeric_limits<T>::is_integer)
+            return 'f';
+        return std::numeric_limits<T>::is_signed ? 'i' : 'u';
+    }
+    template <>
+    inline char itemKind<bool>() { return '?'; }
+
+    /**
+     * Gets a C contiguous view of the buffer exported by \p pyObj if its items are numbers
+     * of the given \p kind (as returned by itemKind()) and \p itemSize. Returns false, without
+     * setting a Python error, if \p pyObj doesn't export such a buffer; otherwise the caller
+     * must release \p view with PyBuffer_Release.
+     */
+    LIBSHIBOKEN_API bool getItems(PyObject* pyObj, Py_buffer* view, char kind, Py_ssize_t itemSize);
+
+    /**
+     * Creates a new writable Python buffer owning storage for \p count numbers of the given
+     * \p kind and \p itemSize, whose address is returned in \p data. Returns NULL, without
+     * setting a Python error, if the buffer protocol has no format for such numbers, or
+     * with a Python error set if the storage couldn't be allocated.
+     */
+    LIBSHIBOKEN_API PyObject* newArray(char kind, Py_ssize_t itemSize, Py_ssize_t count, void** data);
+
+    /**
+     * Appends to the C++ sequence container \p cppOut the items of the buffer exported by
+     * \p pyIn with a single copy, if they are numbers of the container's value type;
+     * array.array, memoryview and numpy arrays are typical inputs. Returns false if that
+     * is not possible, so the caller may fall back to converting each item.
+     */
+    template <typename Container>
+    bool toContainer(PyObject* pyIn, Container& cppOut)
+    {
+        typedef typename Container::value_type T;
+        Py_buffer view;
+        if (!getItems(pyIn, &view, itemKind<T>(), sizeof(T)))
+            return false;
+        const T* begin = reinterpret_cast<const T*>(view.buf);
+        const T* end = begin + view.len / sizeof(T);
+        ThreadStateSaver threadSaver;
+        if (view.len > LargeCopySize)
+            threadSaver.save();
+        cppOut.insert(cppOut.end(), begin, end);
+        threadSaver.restore();
+        PyBuffer_Release(&view);
+        return true;
+    }
+
+    /**
+     * Returns a new Python buffer with a copy of the items of the C++ container \p cppIn,
+     * which must be numbers; on Python 3 it is a memoryview, that works as a read-write
+     * sequence. Returns NULL, without setting a Python error, if the container value type
+     * is not supported, so the caller may fall back to creating a list.
+     * Sequence containers accept the result back in toContainer() without per item conversions.
+     */
+    template <typename Container>
+    PyObject* fromContainer(const Container& cppIn)
+    {
+        typedef typename Container::value_type T;
+        void* data;
+        PyObject* result = newArray(itemKind<T>(), sizeof(T), cppIn.size(), &data);
+        if (!result)
+            return 0;
+        ThreadStateSaver threadSaver;
+        if (Py_ssize_t(cppIn.size() * sizeof(T)) > LargeCopySize)
+            threadSaver.save();
+        std::copy(cppIn.begin(), cppIn.end(), reinterpret_cast<T*>(data));
+        threadSaver.restore();
+        return result;
+    }
+
 } // namespace Buffer
 } // namespace Shiboken
 
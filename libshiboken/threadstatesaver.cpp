@@ -21,12 +21,25 @@
  */
 
 #include "threadstatesaver.h"
+#include "gilstate.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#elif defined(__APPLE__)
+    #include <mach/mach_time.h>
+#else
+    #include <time.h>
+#endif
+
+// Every call is timed until this many calls are made, then just one in SBK_TIMING_INTERVAL.
+#define SBK_TIMING_WARM_UP 16
+#define SBK_TIMING_INTERVAL 64
 
 namespace Shiboken
 {
 
 ThreadStateSaver::ThreadStateSaver()
-        : m_threadState(0)
+        : m_threadState(0), m_gilDepth(0)
     {}
 
 ThreadStateSaver::~ThreadStateSaver()
@@ -36,17 +49,95 @@ ThreadStateSaver::~ThreadStateSaver()
 
 void ThreadStateSaver::save()
 {
-    if (PyEval_ThreadsInitialized())
+    if (PyEval_ThreadsInitialized()) {
+        // GilState objects alive up to here don't protect the code run without the GIL.
+        m_gilDepth = GilState::suspend();
         m_threadState = PyEval_SaveThread();
+    }
 }
 
 void ThreadStateSaver::restore()
 {
     if (m_threadState) {
         PyEval_RestoreThread(m_threadState);
+        GilState::resume(m_gilDepth);
         m_threadState = 0;
     }
 }
 
+static unsigned int autoReleaseThreshold = 20;
+
+// Returns a time stamp in microseconds from a monotonic clock, unaffected by changes of the system time.
+static unsigned long long currentTime()
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)(counter.QuadPart / (frequency.QuadPart / 1000000.0));
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t timebase;
+    if (!timebase.denom)
+        mach_timebase_info(&timebase);
+    return mach_absolute_time() * timebase.numer / timebase.denom / 1000;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+AutoThreadStateSaver::AutoThreadStateSaver(CallTiming& timing)
+    : m_timing(timing), m_start(0), m_timed(false), m_saved(false)
+{
+}
+
+AutoThreadStateSaver::~AutoThreadStateSaver()
+{
+    restore();
+}
+
+void AutoThreadStateSaver::save()
+{
+    // Until a call was timed nothing is known about its duration, so the GIL is released as it
+    // would be without automatic release: a first call may block, waiting for another thread.
+    bool release = m_timing.calls == 0 || m_timing.averageTime >= autoReleaseThreshold;
+    m_timed = m_timing.calls < SBK_TIMING_WARM_UP || m_timing.calls % SBK_TIMING_INTERVAL == 0;
+    m_timing.calls++;
+    if (m_timed)
+        m_start = currentTime();
+    if (release)
+        m_threadStateSaver.save();
+    m_saved = true;
+}
+
+void AutoThreadStateSaver::restore()
+{
+    if (!m_saved)
+        return;
+    m_saved = false;
+    unsigned long long end = m_timed ? currentTime() : 0;
+    // The statistics are shared by all threads, so they are updated only with the GIL held.
+    m_threadStateSaver.restore();
+    if (!m_timed)
+        return;
+    unsigned int elapsed = end > m_start ? (unsigned int)(end - m_start) : 0;
+    if (m_timing.calls == 1)
+        m_timing.averageTime = elapsed;
+    else
+        m_timing.averageTime = (m_timing.averageTime * 7 + elapsed) / 8;
+}
+
+void AutoThreadStateSaver::setThreshold(unsigned int microseconds)
+{
+    autoReleaseThreshold = microseconds;
+}
+
+unsigned int AutoThreadStateSaver::threshold()
+{
+    return autoReleaseThreshold;
+}
+
 } // namespace Shiboken
 
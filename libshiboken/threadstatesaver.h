@@ -38,11 +38,52 @@ public:
     void restore();
 private:
     PyThreadState* m_threadState;
+    int m_gilDepth;
 
     ThreadStateSaver(const ThreadStateSaver&);
     ThreadStateSaver& operator=(const ThreadStateSaver&);
 };
 
+/**
+ *  Timing statistics of a wrapped C++ call, kept by the generated code in a static variable
+ *  initialized with SBK_CALL_TIMING_INITIALIZER and updated by AutoThreadStateSaver.
+ */
+struct CallTiming
+{
+    unsigned int calls;
+    /// Average duration of the sampled calls, in microseconds.
+    unsigned int averageTime;
+};
+
+#define SBK_CALL_TIMING_INITIALIZER { 0, 0 }
+
+/**
+ *  Releases the GIL around a C++ call only if the previous calls made from the same place
+ *  took, on average, at least the time set with setThreshold(). Short calls keep the GIL and
+ *  avoid the cost of releasing and reacquiring it. Only a sample of the calls is timed.
+ */
+class LIBSHIBOKEN_API AutoThreadStateSaver
+{
+public:
+    explicit AutoThreadStateSaver(CallTiming& timing);
+    ~AutoThreadStateSaver();
+    void save();
+    void restore();
+
+    /// Sets the average duration, in microseconds, from which calls are made without the GIL.
+    static void setThreshold(unsigned int microseconds);
+    static unsigned int threshold();
+private:
+    CallTiming& m_timing;
+    ThreadStateSaver m_threadStateSaver;
+    unsigned long long m_start;
+    bool m_timed;
+    bool m_saved;
+
+    AutoThreadStateSaver(const AutoThreadStateSaver&);
+    AutoThreadStateSaver& operator=(const AutoThreadStateSaver&);
+};
+
 } // namespace Shiboken
 
 #endif // THREADSTATESAVER_H
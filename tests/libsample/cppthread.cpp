@@ -0,0 +1,198 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "cppthread.h"
+#include "objecttype.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+typedef void (*ThreadFunction)(void*);
+
+#ifdef _WIN32
+typedef DWORD ThreadId;
+typedef SRWLOCK Mutex;
+#define MUTEX_INITIALIZER SRWLOCK_INIT
+static ThreadId currentThreadId() { return GetCurrentThreadId(); }
+static bool isSameThread(ThreadId a, ThreadId b) { return a == b; }
+static void lockMutex(Mutex* mutex) { AcquireSRWLockExclusive(mutex); }
+static void unlockMutex(Mutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+#else
+typedef pthread_t ThreadId;
+typedef pthread_mutex_t Mutex;
+#define MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+static ThreadId currentThreadId() { return pthread_self(); }
+static bool isSameThread(ThreadId a, ThreadId b) { return pthread_equal(a, b); }
+static void lockMutex(Mutex* mutex) { pthread_mutex_lock(mutex); }
+static void unlockMutex(Mutex* mutex) { pthread_mutex_unlock(mutex); }
+#endif
+
+struct ThreadData
+{
+    ThreadFunction function;
+    void* data;
+};
+
+#ifdef _WIN32
+static DWORD WINAPI threadEntry(LPVOID arg)
+#else
+static void* threadEntry(void* arg)
+#endif
+{
+    ThreadData* threadData = static_cast<ThreadData*>(arg);
+    threadData->function(threadData->data);
+    return 0;
+}
+
+// Runs function(data) on a new native thread and waits for it to finish.
+static void runInCppThread(ThreadFunction function, void* data)
+{
+    ThreadData threadData = { function, data };
+#ifdef _WIN32
+    HANDLE thread = CreateThread(0, 0, threadEntry, &threadData, 0, 0);
+    if (thread) {
+        WaitForSingleObject(thread, INFINITE);
+        CloseHandle(thread);
+    }
+#else
+    pthread_t thread;
+    if (pthread_create(&thread, 0, threadEntry, &threadData) == 0)
+        pthread_join(thread, 0);
+#endif
+}
+
+static void deleteObject(void* object)
+{
+    delete static_cast<ObjectType*>(object);
+}
+
+void
+deleteInCppThread(ObjectType* object)
+{
+    runInCppThread(deleteObject, object);
+}
+
+void
+deletePythonOwnedInCppThread(ObjectType* object)
+{
+    runInCppThread(deleteObject, object);
+}
+
+struct NotifyData
+{
+    ThreadNotifier* notifier;
+    int value;
+};
+
+static void notifyObject(void* data)
+{
+    NotifyData* notifyData = static_cast<NotifyData*>(data);
+    notifyData->notifier->notify(notifyData->value);
+}
+
+void
+ThreadNotifier::notifyInCppThread(int value)
+{
+    NotifyData data = { this, value };
+    runInCppThread(notifyObject, &data);
+}
+
+// Protects the counters below.
+static Mutex recorderMutex = MUTEX_INITIALIZER;
+// Held by the recorder thread while the other threads are blocked.
+static Mutex recorderBlockMutex = MUTEX_INITIALIZER;
+static ThreadId recorderThread = currentThreadId();
+static int destroyed = 0;
+static int destroyedByOtherThreads = 0;
+static int blockedThreads = 0;
+
+DestructionRecorder::~DestructionRecorder()
+{
+    lockMutex(&recorderMutex);
+    bool otherThread = !isSameThread(currentThreadId(), recorderThread);
+    if (otherThread)
+        blockedThreads++;
+    unlockMutex(&recorderMutex);
+    if (otherThread) {
+        lockMutex(&recorderBlockMutex);
+        unlockMutex(&recorderBlockMutex);
+    }
+    lockMutex(&recorderMutex);
+    destroyed++;
+    if (otherThread) {
+        blockedThreads--;
+        destroyedByOtherThreads++;
+    }
+    unlockMutex(&recorderMutex);
+}
+
+void
+DestructionRecorder::reset()
+{
+    lockMutex(&recorderMutex);
+    recorderThread = currentThreadId();
+    destroyed = 0;
+    destroyedByOtherThreads = 0;
+    unlockMutex(&recorderMutex);
+}
+
+int
+DestructionRecorder::destroyedCount()
+{
+    lockMutex(&recorderMutex);
+    int count = destroyed;
+    unlockMutex(&recorderMutex);
+    return count;
+}
+
+int
+DestructionRecorder::destroyedByOtherThreadsCount()
+{
+    lockMutex(&recorderMutex);
+    int count = destroyedByOtherThreads;
+    unlockMutex(&recorderMutex);
+    return count;
+}
+
+int
+DestructionRecorder::blockedThreadsCount()
+{
+    lockMutex(&recorderMutex);
+    int count = blockedThreads;
+    unlockMutex(&recorderMutex);
+    return count;
+}
+
+void
+DestructionRecorder::blockOtherThreads()
+{
+    lockMutex(&recorderBlockMutex);
+}
+
+void
+DestructionRecorder::unblockOtherThreads()
+{
+    unlockMutex(&recorderBlockMutex);
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2012 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CPPTHREAD_H
+#define CPPTHREAD_H
+
+#include "libsamplemacros.h"
+
+class ObjectType;
+
+// Tests objects deleted by threads unknown to Python. Both functions delete the object
+// on a new native thread and wait for it to finish; the first one takes the ownership
+// of the object, while the second one deletes an object still owned by Python.
+LIBSAMPLE_API void deleteInCppThread(ObjectType* object);
+LIBSAMPLE_API void deletePythonOwnedInCppThread(ObjectType* object);
+
+// Tests virtual calls made by threads unknown to Python, notify() is listed
+// with the "queued-virtual-methods" option of the sample binding.
+class LIBSAMPLE_API ThreadNotifier
+{
+public:
+    ThreadNotifier() {}
+    virtual ~ThreadNotifier() {}
+    virtual void notify(int value) {}
+
+    void callNotify(int value) { notify(value); }
+    // Calls notify(value) on a new native thread and waits for it to finish.
+    void notifyInCppThread(int value);
+};
+
+// Tests objects deleted by the background destruction thread. The destructor counts the
+// deletions, telling apart those made by the thread that called reset() from the others.
+class LIBSAMPLE_API DestructionRecorder
+{
+public:
+    DestructionRecorder() {}
+    ~DestructionRecorder();
+
+    // Clears the counters and makes the calling thread the one deleting objects in place.
+    static void reset();
+    static int destroyedCount();
+    static int destroyedByOtherThreadsCount();
+
+    // While blocked, deletions made by other threads wait for unblockOtherThreads().
+    // Both must be called by the thread that called reset().
+    static void blockOtherThreads();
+    static void unblockOtherThreads();
+    // Returns the number of threads deleting an object, which are blocked if the others are.
+    static int blockedThreadsCount();
+};
+
+#endif // CPPTHREAD_H
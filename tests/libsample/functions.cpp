@@ -24,6 +24,14 @@
 #include <string.h>
 #include <iostream>
 
+#ifdef _WIN32
+#include <windows.h>
+#define SLEEP_MSECS(x) Sleep(x)
+#else
+#include <unistd.h>
+#define SLEEP_MSECS(x) usleep((x) * 1000)
+#endif
+
 using namespace std;
 
 void
@@ -178,3 +186,76 @@ acceptOddBoolReference(OddBool& x)
 {
     return x;
 }
+
+std::list<int>
+filterIntegers(const std::list<int>& values, IntegerPredicate predicate, void* userData)
+{
+    std::list<int> result;
+    for (std::list<int>::const_iterator it = values.begin(); it != values.end(); ++it) {
+        if (predicate(*it, userData))
+            result.push_back(*it);
+    }
+    return result;
+}
+
+std::vector<double>
+scaleValues(const std::vector<double>& values, double factor)
+{
+    std::vector<double> result;
+    result.reserve(values.size());
+    for (std::vector<double>::const_iterator it = values.begin(); it != values.end(); ++it)
+        result.push_back(*it * factor);
+    return result;
+}
+
+std::set<int>
+uniqueIntegers(const std::list<int>& values)
+{
+    return std::set<int>(values.begin(), values.end());
+}
+
+int
+sumIntegerSet(const std::set<int>& values)
+{
+    int sum = 0;
+    for (std::set<int>::const_iterator it = values.begin(); it != values.end(); ++it)
+        sum += *it;
+    return sum;
+}
+
+int
+nextSequenceValue()
+{
+    static int value = 0;
+    return ++value;
+}
+
+double
+pointSum(const Point& point)
+{
+    return point.x() + point.y();
+}
+
+double
+pointX(const Point& point)
+{
+    return point.x();
+}
+
+static volatile bool flagRaised = false;
+
+bool
+waitForFlag(int timeout)
+{
+    for (int elapsed = 0; !flagRaised && elapsed < timeout; ++elapsed)
+        SLEEP_MSECS(1);
+    bool result = flagRaised;
+    flagRaised = false;
+    return result;
+}
+
+void
+raiseFlag()
+{
+    flagRaised = true;
+}
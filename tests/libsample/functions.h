@@ -25,10 +25,13 @@
 
 #include "libsamplemacros.h"
 #include <list>
+#include <set>
 #include <utility>
+#include <vector>
 #include "oddbool.h"
 #include "complex.h"
 #include "objecttype.h"
+#include "point.h"
 
 enum GlobalEnum {
     NoThing,
@@ -73,4 +76,23 @@ LIBSAMPLE_API double acceptDouble(double x);
 LIBSAMPLE_API int acceptIntReference(int& x);
 LIBSAMPLE_API OddBool acceptOddBoolReference(OddBool& x);
 
+// Tests C style callbacks receiving user data.
+typedef bool (*IntegerPredicate)(int value, void* userData);
+LIBSAMPLE_API std::list<int> filterIntegers(const std::list<int>& values, IntegerPredicate predicate, void* userData);
+
+// Tests containers converted without a conversion rule in the type system.
+LIBSAMPLE_API std::vector<double> scaleValues(const std::vector<double>& values, double factor);
+LIBSAMPLE_API std::set<int> uniqueIntegers(const std::list<int>& values);
+LIBSAMPLE_API int sumIntegerSet(const std::set<int>& values);
+
+// Tests default values of const reference arguments, built from literals or from a function call.
+LIBSAMPLE_API int nextSequenceValue();
+LIBSAMPLE_API double pointSum(const Point& point = Point(1, 2));
+LIBSAMPLE_API double pointX(const Point& point = Point(nextSequenceValue(), 0));
+
+// Tests the automatic release of the GIL: waitForFlag() returns true if raiseFlag()
+// is called, from another thread, before the given number of milliseconds passes.
+LIBSAMPLE_API bool waitForFlag(int timeout);
+LIBSAMPLE_API void raiseFlag();
+
 #endif // FUNCTIONS_H
@@ -0,0 +1,47 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef INTARRAY_H
+#define INTARRAY_H
+
+#include "libsamplemacros.h"
+#include <vector>
+
+// Growable array of integers exposing its storage through begin() and end() pointers,
+// which are invalidated when it grows.
+class IntArray
+{
+public:
+    IntArray() {}
+
+    int* begin() { return m_values.empty() ? 0 : &m_values[0]; }
+    int* end() { return begin() + m_values.size(); }
+
+    inline int size() const { return m_values.size(); }
+    inline void append(int value) { m_values.push_back(value); }
+    inline void clear() { m_values.clear(); }
+
+private:
+    std::vector<int> m_values;
+};
+
+#endif // INTARRAY_H
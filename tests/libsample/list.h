@@ -50,6 +50,7 @@ public:
     inline IntList(const List<int>& lst) : List<int>(lst), m_ctorUsed(ListOfIntCtor) {}
 
     inline void append(int v) { insert(end(), v); }
+    inline void clear() { List<int>::clear(); }
     CtorEnum constructorUsed() { return m_ctorUsed; }
 private:
     CtorEnum m_ctorUsed;
@@ -59,6 +59,7 @@ public:
 
     inline void setList(std::list<int> lst) { m_lst = lst; }
     inline std::list<int> getList() { return m_lst; }
+    inline const std::list<int>& listView() const { return m_lst; }
 
 private:
     std::list<int> m_lst;
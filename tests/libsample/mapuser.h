@@ -45,6 +45,7 @@ public:
 
     inline void setMap(std::map<std::string, std::list<int> > map) { m_map = map; }
     inline std::map<std::string, std::list<int> > getMap() { return m_map; }
+    inline const std::map<std::string, std::list<int> >& mapView() const { return m_map; }
 
     // Compile test
     static void pointerToMap(std::map<std::string, std::string>* arg) {}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SHAREDPTR_H
+#define SHAREDPTR_H
+
+#include "libsamplemacros.h"
+#include "objecttype.h"
+
+// Minimal reference counted smart pointer.
+template<typename T>
+class SharedPtr
+{
+public:
+    typedef T element_type;
+
+    explicit SharedPtr(T* ptr = 0) : m_ptr(ptr), m_count(ptr ? new int(1) : 0) {}
+    SharedPtr(const SharedPtr& other) : m_ptr(other.m_ptr), m_count(other.m_count)
+    {
+        if (m_count)
+            ++(*m_count);
+    }
+    ~SharedPtr() { release(); }
+
+    SharedPtr& operator=(const SharedPtr& other)
+    {
+        if (other.m_count)
+            ++(*other.m_count);
+        release();
+        m_ptr = other.m_ptr;
+        m_count = other.m_count;
+        return *this;
+    }
+
+    T* get() const { return m_ptr; }
+    int useCount() const { return m_count ? *m_count : 0; }
+
+private:
+    void release()
+    {
+        if (m_count && --(*m_count) == 0) {
+            delete m_ptr;
+            delete m_count;
+        }
+    }
+
+    T* m_ptr;
+    int* m_count;
+};
+
+class SharedObjectTypeUser
+{
+public:
+    SharedPtr<ObjectType> createObject(const char* objectName)
+    {
+        ObjectType* object = new ObjectType;
+        object->setObjectName(objectName);
+        return SharedPtr<ObjectType>(object);
+    }
+
+    void setObject(const SharedPtr<ObjectType>& object) { m_object = object; }
+    SharedPtr<ObjectType> object() const { return m_object; }
+    int objectUseCount() const { return m_object.useCount(); }
+
+private:
+    SharedPtr<ObjectType> m_object;
+};
+
+#endif // SHAREDPTR_H
@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+
+'''Tests the future returning variants of allow-thread methods given by --enable-async-methods.'''
+
+import time
+import unittest
+
+from samplefeatures import Bucket
+
+class AsyncMethodTest(unittest.TestCase):
+
+    def testAsyncLock(self):
+        '''The blocker method runs on a thread of the pool and is unlocked from Python.'''
+        try:
+            import concurrent.futures
+        except ImportError:
+            return
+        bucket = Bucket()
+        future = bucket.lock_async()
+        deadline = time.time() + 10
+        while not bucket.locked():
+            self.assertTrue(time.time() < deadline, 'lock() did not start on the thread pool')
+            time.sleep(0.001)
+        self.assertFalse(future.done())
+        bucket.unlock()
+        self.assertEqual(future.result(10), None)
+        self.assertTrue(future.done())
+
+if __name__ == '__main__':
+    unittest.main()
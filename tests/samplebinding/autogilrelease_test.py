@@ -0,0 +1,61 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Tests the automatic release of the GIL given by --enable-auto-gil-release.'''
+
+import threading
+import unittest
+
+from samplefeatures import raiseFlag, waitForFlag
+
+class Raiser(threading.Thread):
+    '''Raises the flag waited for by the main thread, which needs the GIL released.'''
+    def run(self):
+        raiseFlag()
+
+class AutoGilReleaseTest(unittest.TestCase):
+
+    def waitWithRaiser(self):
+        raiser = Raiser()
+        raiser.start()
+        result = waitForFlag(5000)
+        raiser.join()
+        return result
+
+    def testLongCallsReleaseGil(self):
+        '''Calls without timing data, and calls that took long, are made without the GIL.'''
+        for i in range(3):
+            self.assertTrue(self.waitWithRaiser())
+
+    def testShortCalls(self):
+        '''Short calls, eventually made with the GIL held, still work.'''
+        for i in range(100):
+            raiseFlag()
+            self.assertTrue(waitForFlag(0))
+        self.assertFalse(waitForFlag(0))
+
+if __name__ == '__main__':
+    unittest.main()
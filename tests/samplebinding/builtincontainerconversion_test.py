@@ -0,0 +1,64 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for std containers converted without a conversion rule in the type system.'''
+
+import array
+import unittest
+
+from sample import scaleValues, uniqueIntegers, sumIntegerSet
+
+class BuiltInContainerConversionTest(unittest.TestCase):
+    '''Test cases for std::vector and std::set converted by the generator's built-in rules.'''
+
+    def testVector(self):
+        self.assertEqual(scaleValues([1.0, 2.5], 2), [2.0, 5.0])
+        self.assertEqual(scaleValues((), 2), [])
+
+    def testVectorFromBuffer(self):
+        values = array.array('d', [1.0, 2.0, 3.0])
+        self.assertEqual(scaleValues(values, 0.5), [0.5, 1.0, 1.5])
+
+    def testSetToPython(self):
+        result = uniqueIntegers([3, 1, 3, 2, 1])
+        self.assertEqual(type(result), set)
+        self.assertEqual(result, set([1, 2, 3]))
+
+    def testSetFromIterables(self):
+        self.assertEqual(sumIntegerSet(set([1, 2, 3])), 6)
+        self.assertEqual(sumIntegerSet(frozenset([4, 5])), 9)
+        self.assertEqual(sumIntegerSet([1, 1, 2]), 3)
+        self.assertEqual(sumIntegerSet({7: 'a', 8: 'b'}.keys()), 15)
+
+    def testSetRoundTrip(self):
+        self.assertEqual(sumIntegerSet(uniqueIntegers([5, 5, 6])), 11)
+
+    def testSetFromIteratorIsRefused(self):
+        self.assertRaises(TypeError, sumIntegerSet, iter([1, 2]))
+        self.assertRaises(TypeError, sumIntegerSet, set(['a']))
+
+if __name__ == '__main__':
+    unittest.main()
@@ -39,6 +39,20 @@ class ByteArrayBufferProtocolTest(unittest.TestCase):
         isdir(str(ByteArray('/tmp')))
 
 
+class ByteArrayDataBufferTest(unittest.TestCase):
+    '''Tests the buffer exporting ByteArray data without copies.'''
+
+    def testBufferKeepsOwnerAlive(self):
+        ba = ByteArray('foo\x00bar')
+        buf = ba.dataBuffer()
+        del ba
+        self.assertEqual(bytearray(buf), bytearray(b('foo\x00bar')))
+
+    def testBufferIsReadOnly(self):
+        buf = memoryview(ByteArray('foo').dataBuffer())
+        self.assertTrue(buf.readonly)
+
+
 class ByteArrayConcatenationOperatorTest(unittest.TestCase):
     '''Test cases for ByteArray concatenation with '+' operator.'''
 
@@ -58,6 +72,25 @@ class ByteArrayConcatenationOperatorTest(unittest.TestCase):
         self.assertEqual(result, 'bar\x00foo')
 
 
+class ByteArrayImplicitConversionTest(unittest.TestCase):
+    '''Test cases for objects exporting their memory being passed as ByteArray.'''
+
+    def testAppendPythonByteArray(self):
+        ba = ByteArray('foo')
+        ba.append(bytearray(b('\x00bar')))
+        self.assertEqual(ba, ByteArray(b('foo\x00bar')))
+
+    def testAppendMemoryView(self):
+        ba = ByteArray('foo')
+        ba.append(memoryview(b('bar')))
+        self.assertEqual(ba, 'foobar')
+
+    def testAppendWritableMemoryView(self):
+        ba = ByteArray('foo')
+        ba.append(memoryview(bytearray(b('bar'))))
+        self.assertEqual(ba, 'foobar')
+
+
 class ByteArrayOperatorEqual(unittest.TestCase):
     '''TestCase for operator ByteArray == ByteArray.'''
 
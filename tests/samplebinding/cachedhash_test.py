@@ -0,0 +1,47 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+
+'''Tests the hash values cached for the types given to --cache-hash-types.'''
+
+import unittest
+
+from samplefeatures import Str
+
+class CachedHashTest(unittest.TestCase):
+
+    def testCachedStrHashIsReset(self):
+        '''Str caches its hash, which is discarded by non-const methods and item assignment.'''
+        s = Str("Hi")
+        h = hash(s)
+        self.assertEqual(hash(s), h)
+        s.append(Str(" there"))
+        self.assertEqual(hash(s), hash(Str("Hi there")))
+        s[0] = 'h'
+        self.assertEqual(hash(s), hash(Str("hi there")))
+        s.set_char(0, 'H')
+        self.assertEqual(hash(s), hash(Str("Hi there")))
+
+if __name__ == '__main__':
+    unittest.main()
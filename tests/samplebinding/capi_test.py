@@ -0,0 +1,83 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the C API exported by the generated modules.'''
+
+import ctypes
+import sys
+import unittest
+
+import sample
+import shiboken
+from sample import Point
+
+class SbkCApi(ctypes.Structure):
+    _fields_ = [('version', ctypes.c_int),
+                ('types', ctypes.POINTER(ctypes.c_void_p)),
+                ('typeCount', ctypes.c_int),
+                ('converters', ctypes.c_void_p),
+                ('converterCount', ctypes.c_int),
+                ('cppPointer', ctypes.PYFUNCTYPE(ctypes.c_void_p, ctypes.py_object, ctypes.py_object)),
+                ('pointerToPython', ctypes.PYFUNCTYPE(ctypes.py_object, ctypes.py_object, ctypes.c_void_p))]
+
+def getCApi(module):
+    if sys.version_info[0] >= 3:
+        getPointer = ctypes.pythonapi.PyCapsule_GetPointer
+        getPointer.argtypes = [ctypes.py_object, ctypes.c_char_p]
+        getPointer.restype = ctypes.c_void_p
+        address = getPointer(module._C_API, (module.__name__ + '._C_API').encode())
+    else:
+        getPointer = ctypes.pythonapi.PyCObject_AsVoidPtr
+        getPointer.argtypes = [ctypes.py_object]
+        getPointer.restype = ctypes.c_void_p
+        address = getPointer(module._C_API)
+    return SbkCApi.from_address(address)
+
+class CApiTest(unittest.TestCase):
+
+    def testTypes(self):
+        api = getCApi(sample)
+        self.assertEqual(api.version, 1)
+        self.assertTrue(api.typeCount > 0)
+        types = [api.types[i] for i in range(api.typeCount)]
+        self.assertTrue(id(Point) in types)
+
+    def testCppPointer(self):
+        api = getCApi(sample)
+        pt = Point(1, 2)
+        address = api.cppPointer(pt, Point)
+        self.assertTrue(address)
+        self.assertTrue(api.pointerToPython(Point, address) is pt)
+        self.assertRaises(TypeError, api.cppPointer, sample.ObjectType(), Point)
+
+    def testCppPointerOfDeletedObject(self):
+        api = getCApi(sample)
+        pt = Point(1, 2)
+        shiboken.delete(pt)
+        self.assertRaises(RuntimeError, api.cppPointer, pt, Point)
+
+if __name__ == '__main__':
+    unittest.main()
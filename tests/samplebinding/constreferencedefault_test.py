@@ -0,0 +1,57 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Tests default values of const reference arguments.'''
+
+import unittest
+
+from sample import Point, nextSequenceValue, pointSum, pointX
+
+class ConstReferenceDefaultValueTest(unittest.TestCase):
+    '''Default values built once must not differ from the ones built on every call.'''
+
+    def testLiteralConstructorDefault(self):
+        '''C++ signature: double pointSum(const Point& point = Point(1, 2))'''
+        self.assertEqual(pointSum(), 3)
+        self.assertEqual(pointSum(Point(10, 20)), 30)
+        self.assertEqual(pointSum(), 3)
+
+    def testDefaultUsedAfterImplicitConversion(self):
+        '''An argument implicitly converted from int doesn't replace the default.'''
+        self.assertEqual(pointSum(7), 7)
+        self.assertEqual(pointSum(), 3)
+
+    def testNonLiteralDefaultIsEvaluatedOnEveryCall(self):
+        '''C++ signature: double pointX(const Point& point = Point(nextSequenceValue(), 0))'''
+        first = pointX()
+        second = pointX()
+        self.assertEqual(second, first + 1)
+        self.assertEqual(pointX(Point(-1, 0)), -1)
+        self.assertEqual(nextSequenceValue(), second + 1)
+        self.assertEqual(pointX(), second + 2)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Tests for the read only views given by --enable-const-reference-views.'''
+
+import unittest
+
+import shiboken
+from samplefeatures import Derived, Point, Segment
+
+class ConstReferenceViewTest(unittest.TestCase):
+    '''Const value type fields and const references are read only views of the C++ objects.'''
+
+    def setUp(self):
+        self.segment = Segment(Point(1, 2), Point(3, 4))
+
+    def tearDown(self):
+        del self.segment
+
+    def testConstFieldView(self):
+        '''A const value type field is returned as the same read only view on every access.'''
+        origin = self.segment.origin
+        self.assertTrue(origin is self.segment.origin)
+        self.assertEqual(origin.x(), 1)
+        self.assertEqual(origin.y(), 2)
+
+    def testConstReferenceView(self):
+        '''A value type returned by const reference is a read only view of the C++ object.'''
+        end = self.segment.end()
+        self.assertTrue(end is self.segment.end())
+        self.assertEqual((end.x(), end.y()), (3, 4))
+        self.segment.setEnd(Point(5, 6))
+        self.assertEqual((end.x(), end.y()), (5, 6))
+
+    def testMutationAttempts(self):
+        '''Non const methods called on a read only view raise TypeError.'''
+        origin = self.segment.origin
+        self.assertRaises(TypeError, origin.setX, 10)
+        self.assertRaises(TypeError, origin.setY, 10)
+        end = self.segment.end()
+        self.assertRaises(TypeError, end.setXAsUint, 10)
+        self.assertEqual((end.x(), end.y()), (3, 4))
+
+    def testConstOverloadOnView(self):
+        '''Const methods are still callable on a read only view.'''
+        copy = self.segment.origin.copy()
+        self.assertEqual((copy.x(), copy.y()), (1, 2))
+        copy.setX(10)
+        self.assertEqual(copy.x(), 10)
+        self.assertEqual(self.segment.origin.x(), 1)
+
+    def testOperatorsOnView(self):
+        '''Operators taking the object by const reference are callable on a read only view.'''
+        origin = self.segment.origin
+        doubled = origin * 2
+        self.assertEqual((doubled.x(), doubled.y()), (2, 4))
+        negated = -origin
+        self.assertEqual((negated.x(), negated.y()), (-1, -2))
+        self.assertEqual((origin.x(), origin.y()), (1, 2))
+
+    def testInplaceOperatorOnView(self):
+        '''In-place operators modify the object and are refused on a read only view.'''
+        def addInPlace():
+            origin = self.segment.origin
+            origin += Point(1, 1)
+        self.assertRaises(TypeError, addInPlace)
+        self.assertEqual((self.segment.origin.x(), self.segment.origin.y()), (1, 2))
+
+    def testNonConstFieldWrapperReused(self):
+        '''The wrapper of a non const value type field is also reused on every access.'''
+        d = Derived()
+        d.valueTypeField = Point(10, 20)
+        self.assertTrue(d.valueTypeField is d.valueTypeField)
+        d.valueTypeField.setX(30)
+        self.assertEqual(d.valueTypeField.x(), 30)
+
+    def testViewInvalidatedWithOwner(self):
+        '''Views raise RuntimeError after the C++ object holding them is deleted.'''
+        origin = self.segment.origin
+        shiboken.delete(self.segment)
+        self.assertRaises(RuntimeError, origin.x)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -4,12 +4,14 @@
 #include "bucket.h"
 #include "collector.h"
 #include "complex.h"
+#include "cppthread.h"
 #include "ctorconvrule.h"
 #include "sbkdate.h"
 #include "derived.h"
 #include "echo.h"
 #include "functions.h"
 #include "implicitconv.h"
+#include "intarray.h"
 #include "overloadsort.h"
 #include "handle.h"
 #include "injectcode.h"
@@ -48,6 +50,8 @@
 #include "removednamespaces.h"
 #include "sample.h"
 #include "samplenamespace.h"
+#include "segment.h"
+#include "sharedptr.h"
 #include "simplefile.h"
 #include "size.h"
 #include "str.h"
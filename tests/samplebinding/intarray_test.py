@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+
+'''Test cases for classes iterated through their begin() and end() pointers.'''
+
+import unittest
+
+from sample import IntArray
+
+class IntArrayTest(unittest.TestCase):
+
+    def testIteration(self):
+        array = IntArray()
+        self.assertEqual(list(array), [])
+        for value in (1, 2, 3):
+            array.append(value)
+        self.assertEqual(list(array), [1, 2, 3])
+        self.assertFalse(hasattr(array, 'begin'))
+
+    def testGrowDuringIteration(self):
+        '''Growing reallocates the storage, the iterator must not read the old one.'''
+        array = IntArray()
+        array.append(1)
+        array.append(2)
+        it = iter(array)
+        self.assertEqual(next(it), 1)
+        for value in range(100):
+            array.append(value)
+        self.assertRaises(RuntimeError, next, it)
+
+    def testChangeKeepingSizeDuringIteration(self):
+        array = IntArray()
+        array.append(1)
+        array.append(2)
+        it = iter(array)
+        self.assertEqual(next(it), 1)
+        array.clear()
+        array.append(3)
+        array.append(4)
+        self.assertEqual(next(it), 4)
+        self.assertRaises(StopIteration, next, it)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -26,6 +26,7 @@
 
 import unittest
 
+import shiboken
 from sample import IntList
 
 class IntListTest(unittest.TestCase):
@@ -45,6 +46,45 @@ class IntListTest(unittest.TestCase):
         self.assertEqual(lst[2], 30)
         self.assertEqual(len(lst), 3)
 
+    def testIteration(self):
+        '''IntList is iterated through its C++ iterators.'''
+        lst = IntList()
+        for value in (10, 20, 30):
+            lst.append(value)
+        it = iter(lst)
+        self.assertEqual(next(it), 10)
+        self.assertEqual(list(it), [20, 30])
+        self.assertRaises(StopIteration, next, it)
+        self.assertEqual(list(lst), [10, 20, 30])
+        self.assertEqual(list(IntList()), [])
+
+    def testIterationAfterDelete(self):
+        '''Iterating over a deleted IntList raises RuntimeError.'''
+        lst = IntList([10, 20])
+        it = iter(lst)
+        self.assertEqual(next(it), 10)
+        shiboken.delete(lst)
+        self.assertRaises(RuntimeError, next, it)
+
+    def testResizeDuringIteration(self):
+        '''Changing the IntList size while iterating raises RuntimeError.'''
+        lst = IntList([10, 20])
+        it = iter(lst)
+        self.assertEqual(next(it), 10)
+        lst.append(30)
+        self.assertRaises(RuntimeError, next, it)
+
+    def testChangeKeepingSizeDuringIteration(self):
+        '''Iterating goes on from the same position after the IntList items were replaced.'''
+        lst = IntList([10, 20])
+        it = iter(lst)
+        self.assertEqual(next(it), 10)
+        lst.clear()
+        lst.append(30)
+        lst.append(40)
+        self.assertEqual(next(it), 40)
+        self.assertRaises(StopIteration, next, it)
+
     def testIntListCtor_NoParams(self):
         '''IntList constructor receives no parameter.'''
         il = IntList()
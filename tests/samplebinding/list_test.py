@@ -27,6 +27,8 @@
 '''Test cases for std::list container conversions'''
 
 import unittest
+from array import array
+import shiboken
 
 from sample import ListUser, Point, PointF
 
@@ -92,6 +94,14 @@ class ListConversionTest(unittest.TestCase):
         self.assertNotEqual(result, lst)
         self.assertEqual(result, list(lst))
 
+    def testConversionOfArrayInBothDirections(self):
+        '''Test converting an array of numbers, which exports a buffer, from Python to C++ and back again.'''
+        lu = ListUser()
+        lst = array('i', [3, 5, 7])
+        lu.setList(lst)
+        result = lu.getList()
+        self.assertEqual(result, list(lst))
+
     def testConversionOfListOfObjectsPassedAsArgument(self):
         '''Calls method with a Python list of wrapped objects to be converted to a C++ list.'''
         mult = 3
@@ -111,6 +121,45 @@ class ListConversionTest(unittest.TestCase):
         self.assertEqual(ListUser.ListOfPointF, ListUser.listOfPoints([PointF()]))
         self.assertEqual(ListUser.ListOfPoint, ListUser.listOfPoints([Point()]))
 
+    def testReadOnlyListView(self):
+        '''C++ signature: const std::list<int>& ListUser::listView() const, returned as a view.'''
+        lu = ListUser()
+        lst = [3, 5, 7, 11]
+        lu.setList(lst)
+        view = lu.listView()
+        self.assertEqual(len(view), len(lst))
+        self.assertEqual(view[1], 5)
+        self.assertEqual(view[-1], 11)
+        self.assertEqual(list(view), lst)
+        self.assertEqual(view.copy(), lst)
+        self.assertRaises(IndexError, view.__getitem__, 4)
+        lu.setList([1])
+        self.assertEqual(len(view), 1)
+
+    def testListViewIteration(self):
+        '''A list view iterates over the C++ container, without copying it.'''
+        lu = ListUser()
+        lu.setList([3, 5, 7])
+        it = iter(lu.listView())
+        self.assertEqual(next(it), 3)
+        lu.setList([1, 2])
+        self.assertRaises(RuntimeError, next, it)
+        it = iter(lu.listView())
+        self.assertEqual(next(it), 1)
+        shiboken.delete(lu)
+        self.assertRaises(RuntimeError, next, it)
+
+    def testListViewIterationAfterSizeIsRestored(self):
+        '''Replacing the list with one of the same size doesn't leave the view iterator dangling.'''
+        lu = ListUser()
+        lu.setList([1, 2])
+        it = iter(lu.listView())
+        self.assertEqual(next(it), 1)
+        lu.setList([9])
+        lu.setList([9, 9])
+        self.assertEqual(next(it), 9)
+        self.assertRaises(StopIteration, next, it)
+
 if __name__ == '__main__':
     unittest.main()
 
@@ -71,5 +71,20 @@ class MapConversionTest(unittest.TestCase):
         result = mu.passMapIntValueType(map_)
         self.assertEqual(map_, result)
 
+    def testReadOnlyMapView(self):
+        '''C++ signature: const std::map<std::string, std::list<int> >& MapUser::mapView() const, returned as a view.'''
+        mu = MapUser()
+        map_ = {'odds' : [3, 5, 7], 'evens' : [2, 4, 6]}
+        mu.setMap(map_)
+        view = mu.mapView()
+        self.assertEqual(len(view), 2)
+        self.assertEqual(view['odds'], [3, 5, 7])
+        self.assertTrue('evens' in view)
+        self.assertFalse('primes' in view)
+        self.assertRaises(KeyError, view.__getitem__, 'primes')
+        self.assertEqual(sorted(view.keys()), ['evens', 'odds'])
+        self.assertEqual(view.copy(), map_)
+        self.assertEqual(sorted(iter(view)), ['evens', 'odds'])
+
 if __name__ == '__main__':
     unittest.main()
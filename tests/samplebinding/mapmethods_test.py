@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+
+'''Tests the variants calling a method on sequences of objects given by --enable-map-methods.'''
+
+import unittest
+
+from samplefeatures import ObjectType, Point
+
+class MapMethodTest(unittest.TestCase):
+
+    def testMapValues(self):
+        '''The results of the calls are returned in a list, in the order of the objects.'''
+        points = [Point(i, i * 2) for i in range(5)]
+        self.assertEqual(Point.x_map(points), [0.0, 1.0, 2.0, 3.0, 4.0])
+        self.assertEqual(Point.y_map(tuple(points)), [0.0, 2.0, 4.0, 6.0, 8.0])
+        self.assertEqual(Point.x_map([]), [])
+
+    def testPythonSubclass(self):
+        '''Like an unbound method call, Python reimplementations are not called.'''
+        class DerivedPoint(Point):
+            def x(self):
+                return -1.0
+        self.assertEqual(Point.x_map([Point(1, 2), DerivedPoint(3, 4)]), [1.0, 3.0])
+
+    def testWrongObjects(self):
+        '''All the objects are checked before any call.'''
+        self.assertRaises(TypeError, Point.x_map, [Point(), ObjectType()])
+        self.assertRaises(TypeError, Point.x_map, 1)
+
+if __name__ == '__main__':
+    unittest.main()
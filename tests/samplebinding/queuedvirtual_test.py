@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+
+'''Tests virtual calls made by C++ threads, queued by --queued-virtual-methods.'''
+
+import time
+import unittest
+
+from samplefeatures import ThreadNotifier
+
+class Notifier(ThreadNotifier):
+    def __init__(self):
+        ThreadNotifier.__init__(self)
+        self.values = []
+
+    def notify(self, value):
+        self.values.append(value)
+
+class QueuedVirtualTest(unittest.TestCase):
+
+    def testCallFromPythonThread(self):
+        '''Calls made by a thread known to Python are not queued.'''
+        notifier = Notifier()
+        notifier.callNotify(1)
+        self.assertEqual(notifier.values, [1])
+
+    def testCallFromCppThread(self):
+        '''Calls made by a native thread are queued and run by the interpreter in order.'''
+        notifier = Notifier()
+        notifier.notifyInCppThread(1)
+        notifier.notifyInCppThread(2)
+        deadline = time.time() + 10
+        while len(notifier.values) < 2 and time.time() < deadline:
+            time.sleep(0.01)
+        self.assertEqual(notifier.values, [1, 2])
+
+if __name__ == '__main__':
+    unittest.main()
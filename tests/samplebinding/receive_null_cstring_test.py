@@ -29,6 +29,7 @@
 import unittest
 
 from sample import countCharacters
+from py3kcompat import b
 
 class ReceiveNullCStringTest(unittest.TestCase):
     '''Test case for a function that could receive a NULL pointer in a '[const] char*' parameter.'''
@@ -40,6 +41,12 @@ class ReceiveNullCStringTest(unittest.TestCase):
         self.assertEqual(countCharacters(a), len(a))
         self.assertEqual(countCharacters(b), len(b))
 
+    def testBytesLikeObjects(self):
+        '''Bytes and bytearray objects are accepted as '[const] char*', other buffers are not.'''
+        self.assertEqual(countCharacters(b('abc')), 3)
+        self.assertEqual(countCharacters(bytearray(b('abcd'))), 4)
+        self.assertRaises(TypeError, countCharacters, memoryview(b('ab\x00')))
+
     def testReceiveNull(self):
         '''The test function returns '-1' when receives a None value instead of a string.'''
         self.assertEqual(countCharacters(None), -1)
@@ -37,5 +37,15 @@ class TestRichCompare(unittest.TestCase):
         d = a + c < b + a
         self.assertEqual(d.toString(), "((2+(2+3))<(3+2))")
 
+    def testSameTypeComparison(self):
+        '''Str objects compared to each other and to convertible values.'''
+        values = [Str('c'), Str('a'), Str('b')]
+        self.assertEqual([str(v) for v in sorted(values)], ['a', 'b', 'c'])
+        self.assertTrue(Str('a') < Str('b'))
+        self.assertTrue(Str('a') == Str('a'))
+        self.assertFalse(Str('a') == Str('b'))
+        self.assertTrue(Str('a') == 'a')
+        self.assertTrue(Str('a') < 'b')
+
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2009 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for objects held by smart pointers.'''
+
+import unittest
+
+import shiboken
+from sample import ObjectType, SharedObjectTypeUser
+
+class SharedPtrTest(unittest.TestCase):
+
+    def testIdentity(self):
+        user = SharedObjectTypeUser()
+        obj = user.createObject('shared')
+        self.assertFalse(shiboken.ownedByPython(obj))
+        user.setObject(obj)
+        self.assertTrue(user.object() is obj)
+        # One for the wrapper, one for the user.
+        self.assertEqual(user.objectUseCount(), 2)
+
+    def testObjectOutlivesWrapper(self):
+        user = SharedObjectTypeUser()
+        user.setObject(user.createObject('shared'))
+        self.assertEqual(user.objectUseCount(), 1)
+        obj = user.object()
+        self.assertEqual(obj.objectName(), 'shared')
+        self.assertEqual(user.objectUseCount(), 2)
+        del obj
+        self.assertEqual(user.objectUseCount(), 1)
+
+    def testAdoptPythonObject(self):
+        user = SharedObjectTypeUser()
+        obj = ObjectType()
+        obj.setObjectName('adopted')
+        user.setObject(obj)
+        self.assertFalse(shiboken.ownedByPython(obj))
+        self.assertTrue(user.object() is obj)
+        del obj
+        self.assertEqual(user.object().objectName(), 'adopted')
+
+    def testOwnershipChangesAreIgnored(self):
+        user = SharedObjectTypeUser()
+        obj = ObjectType()
+        obj.setObjectName('held')
+        user.setObject(obj)
+        parent = ObjectType()
+        obj.setParent(parent)
+        # The C++ parent would delete the object, the smart pointers must stay its only owners.
+        self.assertTrue(parent.takeChild(obj) is obj)
+        self.assertFalse(shiboken.ownedByPython(obj))
+        del parent
+        del obj
+        self.assertEqual(user.object().objectName(), 'held')
+        self.assertEqual(user.objectUseCount(), 1)
+
+    def testNone(self):
+        user = SharedObjectTypeUser()
+        self.assertEqual(user.object(), None)
+        user.setObject(user.createObject('shared'))
+        user.setObject(None)
+        self.assertEqual(user.objectUseCount(), 0)
+
+    def testInvalidObject(self):
+        user = SharedObjectTypeUser()
+        self.assertRaises(TypeError, user.setObject, 42)
+        parent = ObjectType()
+        child = ObjectType(parent)
+        self.assertRaises(TypeError, user.setObject, child)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -179,6 +179,25 @@ class StringBasedConversionTest(unittest.TestCase):
         for orig, new in zip(integers, result):
             self.assertEqual(orig, new)
 
+    def testCallPythonFromCpp(self):
+        args = sample.callWithPoint(lambda *args: args, sample.Point(1, 2))
+        self.assertEqual(args, (sample.Point(1, 2), 1.0, 'point'))
+        pt = sample.callReturningPoint(lambda pt: pt * 2, sample.Point(1, 2))
+        self.assertEqual(pt, sample.Point(2, 4))
+        self.assertRaises(TypeError, sample.callReturningPoint, lambda pt: 'not a point', sample.Point())
+        self.assertRaises(ZeroDivisionError, sample.callReturningPoint, lambda pt: 1 / 0, sample.Point())
+
+    def testCallPythonFromCppWithConstPointer(self):
+        obj = sample.ObjectType()
+        self.assertTrue(sample.callWithConstObject(lambda o: o, obj) is obj)
+
+    def testPythonFunctionAsCallback(self):
+        self.assertEqual(sample.filterIntegers([1, 2, 3, 4, 5], lambda x: x % 2), [1, 3, 5])
+        def fail(x):
+            raise ValueError(x)
+        self.assertRaises(ValueError, sample.filterIntegers, [1, 2], fail)
+        self.assertRaises(TypeError, sample.filterIntegers, [1, 2], 3)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -1,4 +1,5 @@
 import shiboken
+import time
 import unittest
 from sample import *
 
@@ -7,6 +8,13 @@ class MultipleInherited (ObjectType, Point):
         ObjectType.__init__(self)
         Point.__init__(self)
 
+def waitForBlockedDestruction():
+    # Waits for the background thread to get stuck deleting a DestructionRecorder.
+    deadline = time.time() + 10
+    while DestructionRecorder.blockedThreadsCount() == 0 and time.time() < deadline:
+        time.sleep(0.01)
+    return DestructionRecorder.blockedThreadsCount() == 1
+
 class TestShiboken(unittest.TestCase):
     def testIsValid(self):
         self.assertTrue(shiboken.isValid(object()))
@@ -66,6 +74,101 @@ class TestShiboken(unittest.TestCase):
         self.assertFalse(shiboken.isValid(obj))
         self.assertFalse(shiboken.isValid(child))
 
+    def testDeferredDestruction(self):
+        shiboken.setDeferredDestruction(True)
+        try:
+            obj = ObjectType()
+            child = ObjectType(obj)
+            # Objects deleted by a thread holding the GIL are destroyed right away.
+            shiboken.delete(obj)
+            self.assertFalse(shiboken.isValid(obj))
+            self.assertFalse(shiboken.isValid(child))
+            shiboken.processDeferredDestructions()
+        finally:
+            shiboken.setDeferredDestruction(False)
+
+    def testDeferredDestructionFromCppThread(self):
+        shiboken.setDeferredDestruction(True)
+        try:
+            obj = ObjectType()
+            child = ObjectType(obj)
+            # The C++ thread deletes the object without waiting for the GIL, held by this thread.
+            deleteInCppThread(obj)
+            self.assertFalse(shiboken.isValid(obj))
+            self.assertFalse(shiboken.isValid(child))
+            shiboken.processDeferredDestructions()
+            self.assertFalse(shiboken.isValid(obj))
+            self.assertFalse(shiboken.isValid(child))
+        finally:
+            shiboken.setDeferredDestruction(False)
+
+    def testDeferredDestructionOfPythonOwnedObject(self):
+        shiboken.setDeferredDestruction(True)
+        try:
+            obj = ObjectType()
+            self.assertTrue(shiboken.ownedByPython(obj))
+            deletePythonOwnedInCppThread(obj)
+            self.assertFalse(shiboken.isValid(obj))
+            # The wrapper goes away before the queue is processed, without deleting the C++ object again.
+            del obj
+            shiboken.processDeferredDestructions()
+        finally:
+            shiboken.setDeferredDestruction(False)
+
+    def testBackgroundDestruction(self):
+        DestructionRecorder.reset()
+        shiboken.setBackgroundDestruction(DestructionRecorder, True)
+        DestructionRecorder.blockOtherThreads()
+        try:
+            recorders = [DestructionRecorder() for i in range(10)]
+            del recorders
+            self.assertTrue(waitForBlockedDestruction())
+            self.assertEqual(DestructionRecorder.destroyedCount(), 0)
+        finally:
+            DestructionRecorder.unblockOtherThreads()
+            # Waits for the background thread, which empties the queue before letting go.
+            shiboken.flushBackgroundDestructions()
+            shiboken.setBackgroundDestruction(DestructionRecorder, False)
+        self.assertEqual(DestructionRecorder.destroyedCount(), 10)
+        self.assertEqual(DestructionRecorder.destroyedByOtherThreadsCount(), 10)
+        self.assertRaises(TypeError, shiboken.setBackgroundDestruction, int, True)
+
+    def testBackgroundDestructionWithFullQueue(self):
+        DestructionRecorder.reset()
+        shiboken.setBackgroundDestruction(DestructionRecorder, True)
+        shiboken.setBackgroundDestructionQueueSize(1)
+        DestructionRecorder.blockOtherThreads()
+        try:
+            recorders = [DestructionRecorder() for i in range(10)]
+            blocked = recorders.pop(0)
+            del blocked
+            self.assertTrue(waitForBlockedDestruction())
+            # One object waits in the queue, the others are deleted right away by this thread.
+            del recorders
+            self.assertEqual(DestructionRecorder.destroyedCount(), 8)
+            self.assertEqual(DestructionRecorder.destroyedByOtherThreadsCount(), 0)
+        finally:
+            DestructionRecorder.unblockOtherThreads()
+            shiboken.flushBackgroundDestructions()
+            shiboken.setBackgroundDestructionQueueSize(256)
+            shiboken.setBackgroundDestruction(DestructionRecorder, False)
+        self.assertEqual(DestructionRecorder.destroyedCount(), 10)
+        self.assertEqual(DestructionRecorder.destroyedByOtherThreadsCount(), 2)
+
+    def testBackgroundDestructionOfCppWrapperClass(self):
+        # ObjectType instances created from Python are C++ wrapper (shell) objects, whose
+        # destructor needs the GIL, so they are still deleted right away.
+        shiboken.setBackgroundDestruction(ObjectType, True)
+        try:
+            parent = ObjectType()
+            children = [ObjectType(parent) for i in range(10)]
+            del parent
+            for child in children:
+                self.assertFalse(shiboken.isValid(child))
+            shiboken.flushBackgroundDestructions()
+        finally:
+            shiboken.setBackgroundDestruction(ObjectType, False)
+
     def testVersionAttr(self):
         self.assertEqual(type(shiboken.__version__), str)
         self.assertTrue(len(shiboken.__version__) >= 5)